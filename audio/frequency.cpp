@@ -1,5 +1,6 @@
 #include <audio/frequency.h>
 #include <base/logger.h>
+#include <limits>
 
 namespace gbemu {
 
@@ -45,20 +46,28 @@ bool Frequency::writeByte(
 }
 
 
-bool Frequency::emulate()
+bool Frequency::emulate(const int nbCycles)
 {
     if (_frequencyTimer.getCycleLength() == 0) {
         return false;
     }
 
     // If frequency timer didn't underflow, output doesn't change.
-    if (!_frequencyTimer.increment()) {
+    if (!_frequencyTimer.advance(nbCycles)) {
         return false;
     }
     _frequencyTimer = Counter(0, _frequencyPeriod);
     return true;
 }
 
+int Frequency::getCyclesToNextStep() const
+{
+    if (_frequencyTimer.getCycleLength() == 0) {
+        return std::numeric_limits<int>::max();
+    }
+    return _frequencyTimer.getCyclesToOverflow();
+}
+
 short Frequency::computeFrequencyPeriod() const
 {
     return (
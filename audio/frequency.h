@@ -36,7 +36,10 @@ namespace gbemu {
         );
         bool writeByte( unsigned short addr, unsigned char value );
         unsigned char readByte( unsigned short addr ) const;
-        bool emulate();
+        // Runs nbCycles cycles, which must not go past the next step.
+        // Returns true if the frequency stepped.
+        bool emulate(int nbCycles = 1);
+        int getCyclesToNextStep() const;
     protected:
         Register< FrequencyLoBits, 0x0, 0xFF >                 _rFrequencyLo;
         Register< FrequencyHiBits, 0x40, 0XFF >                _rFrequencyHiPlayback;
@@ -1,8 +1,10 @@
 #include <audio/papu.h>
 #include <cpu/registers.h>
 #include <common/common.h>
+#include <common/policy.h>
 #include <base/logger.h>
 #include <base/clock.imp.h>
+#include <algorithm>
 #include <iostream>
 
 namespace gbemu {
@@ -50,18 +52,33 @@ PAPU::PAPU( const CPUClock& clock ) :
 void PAPU::emulate(int nbCycles)
 {
     const int64_t endTick = _clocks.cpu.getTimeInCycles();
-    for (int64_t i = endTick - nbCycles; i < endTick; ++i) {
+    if (EmulationPolicy::kBatchAudio) {
+        emulateEvents(endTick - nbCycles, endTick);
+    }
+    else {
+        emulateCycles(endTick - nbCycles, endTick);
+    }
+}
+
+void PAPU::clock512Hz()
+{
+    if (_clocks.lengthClock.increment()) {
+        // FIXME: Implement.
+    }
+    if (_clocks.volumeEnvelopeClock.increment()) {
+        _squareWaveChannel1.clockEnvelope();
+        _squareWaveChannel2.clockEnvelope();
+    }
+    if (_clocks.sweepClock.increment()) {
+        // FIXME: Implement.
+    }
+}
+
+void PAPU::emulateCycles(const int64_t startTick, const int64_t endTick)
+{
+    for (int64_t i = startTick; i < endTick; ++i) {
         if (_clocks.hz512Clock.increment()) {
-            if (_clocks.lengthClock.increment()) {
-                // FIXME: Implement.
-            }
-            if (_clocks.volumeEnvelopeClock.increment()) {
-                _squareWaveChannel1.clockEnvelope();
-                _squareWaveChannel2.clockEnvelope();
-            }
-            if (_clocks.sweepClock.increment()) {
-                // FIXME: Implement.
-            }
+            clock512Hz();
         }
         _squareWaveChannel1.emulate(i);
         _squareWaveChannel2.emulate(i);
@@ -69,6 +86,29 @@ void PAPU::emulate(int nbCycles)
     }
 }
 
+void PAPU::emulateEvents(const int64_t startTick, const int64_t endTick)
+{
+    // Nothing changes between the 512Hz clock ticks and the frequency steps
+    // of the channels, so jump from one to the next. Each of them happens on
+    // the last cycle of a run, in the same order as in emulateCycles.
+    for (int64_t i = startTick; i < endTick; ) {
+        const int nbCycles = std::min({
+            static_cast<int>(endTick - i),
+            _clocks.hz512Clock.getCyclesToNextTick(),
+            _squareWaveChannel1.getCyclesToNextStep(),
+            _squareWaveChannel2.getCyclesToNextStep(),
+            _waveChannel.getCyclesToNextStep()
+        });
+        i += nbCycles;
+        if (_clocks.hz512Clock.advance(nbCycles)) {
+            clock512Hz();
+        }
+        _squareWaveChannel1.emulate(i - 1, nbCycles);
+        _squareWaveChannel2.emulate(i - 1, nbCycles);
+        _waveChannel.emulate(i - 1, nbCycles);
+    }
+}
+
 void PAPU::writeByte(
     const unsigned short addr,
     const unsigned char value
@@ -32,6 +32,9 @@ namespace gbemu {
         float getCurrentPlaybackTime() const;
         void emulate(int nbCycles);
     private:
+        void clock512Hz();
+        void emulateCycles(int64_t startTick, int64_t endTick);
+        void emulateEvents(int64_t startTick, int64_t endTick);
         void renderAudioInternal(void* output, const unsigned long sampleCount, const int rate);
 
         class NR52bits
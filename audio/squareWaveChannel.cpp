@@ -75,10 +75,10 @@ void SquareWaveChannel::writeByte(
     }
 }
 
-void SquareWaveChannel::emulate(int64_t currentCycle)
+void SquareWaveChannel::emulate(int64_t currentCycle, int nbCycles)
 {
     // If the frequency clock hasn't overflowed
-    if ( !Frequency::emulate() ) {
+    if ( !Frequency::emulate( nbCycles ) ) {
         return;
     }
     _currentDutyStep.increment();
@@ -72,7 +72,7 @@ namespace gbemu {
         bool contains(unsigned short addr) const;
         void writeByte( unsigned short addr, unsigned char value );
         unsigned char readByte( unsigned short addr ) const;
-        void emulate(int64_t cycle);
+        void emulate(int64_t cycle, int nbCycles = 1);
     private:
         short getGbNote() const;
 
@@ -59,10 +59,10 @@ void WaveChannel::writeByte(
     }
 }
 
-void WaveChannel::emulate(int64_t currentCycle)
+void WaveChannel::emulate(int64_t currentCycle, int nbCycles)
 {
     // If the frequency clock hasn't overflowed
-    if ( !Frequency::emulate() ) {
+    if ( !Frequency::emulate( nbCycles ) ) {
         return;
     }
 
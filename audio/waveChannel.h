@@ -57,7 +57,7 @@ namespace gbemu {
         );
         void writeByte( unsigned short addr, unsigned char value );
         bool contains(unsigned short addr) const;
-        void emulate(int64_t currentCycle);
+        void emulate(int64_t currentCycle, int nbCycles = 1);
 
     private:
         // Current step in the played frequency.
@@ -27,6 +27,10 @@ namespace gbemu {
         int count() const;
         void reset();
         bool increment();
+        // Increments nbCycles times, which must not go past the next tick.
+        // Returns true if the clock ticked.
+        bool advance(int nbCycles);
+        int getCyclesToNextTick() const;
     private:
         int _count;
     };
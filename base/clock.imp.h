@@ -18,6 +18,19 @@ JFX_INLINE bool ClockT<CycleLength, ClockAt>::increment()
     return _count == ClockAt;
 }
 
+template<int CycleLength, int ClockAt>
+JFX_INLINE bool ClockT<CycleLength, ClockAt>::advance(int const nbCycles)
+{
+    _count = (_count + nbCycles) % CycleLength;
+    return _count == ClockAt;
+}
+
+template<int CycleLength, int ClockAt>
+JFX_INLINE int ClockT<CycleLength, ClockAt>::getCyclesToNextTick() const
+{
+    return (ClockAt - _count - 1 + CycleLength) % CycleLength + 1;
+}
+
 template<int CycleLength, int ClockAt>
 int ClockT<CycleLength, ClockAt>::count() const
 {
@@ -14,6 +14,17 @@ namespace gbemu {
         return _count == 0;
     }
 
+    bool Counter::advance(int nbCycles)
+    {
+        _count = (_count + nbCycles) % _cycleLength;
+        return _count == 0;
+    }
+
+    int Counter::getCyclesToOverflow() const
+    {
+        return _cycleLength - _count;
+    }
+
     int Counter::getCycleLength() const
     {
         return _cycleLength;
@@ -7,6 +7,10 @@ namespace gbemu {
     public:
         Counter(int count = 0, int cycleLength = 1);
         bool increment();
+        // Increments nbCycles times, which must not go past the next
+        // overflow. Returns true if the counter overflowed.
+        bool advance(int nbCycles);
+        int getCyclesToOverflow() const;
         int count() const;
         void reset();
         int getCycleLength() const;
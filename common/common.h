@@ -4,9 +4,11 @@
 #include <fstream>
 #include <vector>
 #include <cassert>
+#include <cstring>
 
 #ifdef WINDOWS
 #pragma warning ( disable : /*4482 4480*/ 4201 )
+#include <intrin.h>
 #endif
 
 #define JFX_INLINE inline
@@ -155,6 +157,37 @@ namespace gbemu {
         }
     }
     
+    // Index of the lowest bit set, value must not be 0.
+    JFX_INLINE unsigned int countTrailingZeros( unsigned int value )
+    {
+#ifdef WINDOWS
+        unsigned long index;
+        _BitScanForward( &index, value );
+        return index;
+#else
+        return __builtin_ctz( value );
+#endif
+    }
+
+    // The Game Boy stores its words little endian, whatever the host does.
+    JFX_INLINE unsigned short loadLittleEndianWord( const unsigned char* bytes )
+    {
+        unsigned short value;
+        memcpy( &value, bytes, sizeof( value ) );
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = static_cast< unsigned short >( ( value >> 8 ) | ( value << 8 ) );
+#endif
+        return value;
+    }
+
+    JFX_INLINE void storeLittleEndianWord( unsigned char* bytes, unsigned short value )
+    {
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = static_cast< unsigned short >( ( value >> 8 ) | ( value << 8 ) );
+#endif
+        memcpy( bytes, &value, sizeof( value ) );
+    }
+
     template< typename T >
     JFX_INLINE unsigned char lowNibble( T b )
     {
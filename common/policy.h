@@ -0,0 +1,33 @@
+#pragma once
+
+namespace gbemu {
+
+    // Shortcuts the emulator can take to run faster. The fast policy takes
+    // all of them. The accurate policy runs every cycle of every component
+    // so it can be used to validate the shortcuts.
+    struct FastPolicy
+    {
+        // Jumps to the next video or timer event while the cpu is halted.
+        static const bool kFastForwardHalt = true;
+        // Skips the iterations of loops that only poll hardware registers.
+        static const bool kSkipIdleLoops = true;
+        // Runs the sound channels from one event to the next instead of one
+        // cycle at a time.
+        static const bool kBatchAudio = true;
+    };
+
+    struct AccuratePolicy
+    {
+        static const bool kFastForwardHalt = false;
+        static const bool kSkipIdleLoops = false;
+        static const bool kBatchAudio = false;
+    };
+
+    // The policy is picked at build time so the code of the other one is
+    // compiled out.
+#ifdef GBEMU_ACCURATE
+    typedef AccuratePolicy EmulationPolicy;
+#else
+    typedef FastPolicy EmulationPolicy;
+#endif
+}
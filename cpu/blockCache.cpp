@@ -0,0 +1,545 @@
+#include <cpu/blockCache.h>
+#include <memory/memory.h>
+#include <cstring>
+
+namespace {
+
+    using namespace gbemu;
+
+    const size_t kMaxInstructionsPerBlock = 32;
+
+    // Registers are numbered like in the opcodes: B, C, D, E, H, L, (HL), A.
+    // (HL) isn't a register, so its bit is used for the flags.
+    const unsigned int kRegH = 4;
+    const unsigned int kRegL = 5;
+    const unsigned int kRegMHL = 6;
+    const unsigned int kRegA = 7;
+    const unsigned int kFlags = 1 << kRegMHL;
+
+    unsigned int regBit( const unsigned int reg )
+    {
+        return 1 << reg;
+    }
+
+    // What an instruction of an idle loop reads and writes.
+    struct LoopAccess
+    {
+        unsigned int reads;
+        unsigned int writes;
+        // Memory read by the instruction, or -1.
+        int          address;
+    };
+
+    // Returns true if the flags an instruction leaves depend on the flags it
+    // was given.
+    bool readsFlags( const OpcodeInfo& info )
+    {
+        return info.flagsRead != 0 || ( info.flagsWritten != 0 && info.flagsWritten != 0xF0 );
+    }
+
+    // Fills access for instructions that only touch registers or read
+    // memory, returns false for anything else. hl is the value of HL if it
+    // is known, or -1.
+    bool getRegisterAccess( const Instruction& instruction, const int hl, LoopAccess& access )
+    {
+        access.reads = 0;
+        access.writes = 0;
+        access.address = -1;
+
+        if ( isCBOpcode( static_cast< Opcode >( instruction.opcode ) ) ) {
+            const unsigned int reg = instruction.opcode & 0x7;
+            const unsigned int group = ( instruction.opcode >> 6 ) & 0x3;
+            if ( reg == kRegMHL ) {
+                // Only BIT can look at (HL) without writing to it.
+                if ( group != 1 || hl < 0 ) {
+                    return false;
+                }
+                access.address = hl;
+                access.reads = regBit( kRegH ) | regBit( kRegL );
+                return true;
+            }
+            access.reads = regBit( reg );
+            // BIT only sets the flags.
+            access.writes = group == 1 ? 0 : regBit( reg );
+            return true;
+        }
+
+        const unsigned char opcode = static_cast< unsigned char >( instruction.opcode );
+        if ( opcode >= 0x40 && opcode < 0x80 ) {
+            const unsigned int dst = ( opcode >> 3 ) & 0x7;
+            const unsigned int src = opcode & 0x7;
+            // HALT and writes to (HL)
+            if ( dst == kRegMHL ) {
+                return false;
+            }
+            if ( src == kRegMHL ) {
+                if ( hl < 0 ) {
+                    return false;
+                }
+                access.address = hl;
+                access.reads = regBit( kRegH ) | regBit( kRegL );
+            }
+            else {
+                access.reads = regBit( src );
+            }
+            access.writes = regBit( dst );
+            return true;
+        }
+        if ( ( opcode >= 0x80 && opcode < 0xC0 ) || ( opcode & 0xC7 ) == 0xC6 ) {
+            const unsigned int operation = ( opcode >> 3 ) & 0x7;
+            const bool isImmediate = opcode >= 0xC0;
+            const unsigned int src = opcode & 0x7;
+            if ( !isImmediate && src == kRegMHL ) {
+                if ( hl < 0 ) {
+                    return false;
+                }
+                access.address = hl;
+                access.reads = regBit( kRegH ) | regBit( kRegL );
+            }
+            else if ( !isImmediate ) {
+                access.reads = regBit( src );
+            }
+            // SUB A and XOR A give the same result whatever A is.
+            if ( isImmediate || src != kRegA || ( operation != 2 && operation != 5 ) ) {
+                access.reads |= regBit( kRegA );
+            }
+            // CP only sets the flags.
+            access.writes = operation == 7 ? 0 : regBit( kRegA );
+            return true;
+        }
+        if ( ( opcode & 0xC7 ) == 0x04 || ( opcode & 0xC7 ) == 0x05 ) {
+            const unsigned int reg = ( opcode >> 3 ) & 0x7;
+            if ( reg == kRegMHL ) {
+                return false;
+            }
+            access.reads = regBit( reg );
+            access.writes = regBit( reg );
+            return true;
+        }
+        if ( ( opcode & 0xC7 ) == 0x06 ) {
+            const unsigned int reg = ( opcode >> 3 ) & 0x7;
+            if ( reg == kRegMHL ) {
+                return false;
+            }
+            access.writes = regBit( reg );
+            return true;
+        }
+        switch( opcode ) {
+            case 0x00: // NOP
+            case 0x18: // JR n
+            case 0xC3: // JP nn
+            case 0x20: case 0x28: case 0x30: case 0x38: // JR cc, n
+            case 0xC2: case 0xCA: case 0xD2: case 0xDA: // JP cc, nn
+            case 0x37: case 0x3F: // SCF, CCF
+                return true;
+            case 0x07: case 0x0F: // RLCA, RRCA
+            case 0x17: case 0x1F: // RLA, RRA
+            case 0x2F: // CPL
+                access.reads = regBit( kRegA );
+                access.writes = regBit( kRegA );
+                return true;
+            case 0x21: // LD HL, nn
+                access.writes = regBit( kRegH ) | regBit( kRegL );
+                return true;
+            case 0xF0: // LDH A, (n)
+                access.address = 0xFF00 | instruction.operands[ 0 ];
+                access.writes = regBit( kRegA );
+                return true;
+            case 0xFA: // LD A, (nn)
+                access.address = instruction.operands[ 0 ] | ( instruction.operands[ 1 ] << 8 );
+                access.writes = regBit( kRegA );
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Same as getRegisterAccess, with the flags the opcode table says the
+    // instruction reads and writes.
+    bool getLoopAccess( const Instruction& instruction, const int hl, LoopAccess& access )
+    {
+        if ( !getRegisterAccess( instruction, hl, access ) ) {
+            return false;
+        }
+        const OpcodeInfo& info( getOpcodeInfo( static_cast< Opcode >( instruction.opcode ) ) );
+        if ( readsFlags( info ) ) {
+            access.reads |= kFlags;
+        }
+        if ( info.flagsWritten != 0 ) {
+            access.writes |= kFlags;
+        }
+        return true;
+    }
+
+    // Memory an idle loop can poll. These only change on video and timer
+    // events or in interrupt handlers.
+    bool isIdleLoopInput( const unsigned short addr )
+    {
+        return addr == kLY || addr == kSTAT || addr == kIF || addr == kDIV ||
+               Memory::isInternalRAM( addr ) || Memory::isHighRAM( addr );
+    }
+
+    // Address a jump instruction goes to, or -1 for other instructions.
+    int getJumpTarget( const Instruction& instruction )
+    {
+        switch( instruction.opcode ) {
+            case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+                return ( instruction.addr + instruction.length +
+                         static_cast< signed char >( instruction.operands[ 0 ] ) ) & 0xFFFF;
+            case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA:
+                return instruction.operands[ 0 ] | ( instruction.operands[ 1 ] << 8 );
+            default:
+                return -1;
+        }
+    }
+
+    void analyzeIdleLoop( Block& block )
+    {
+        if ( getJumpTarget( block.instructions.back() ) != block.start ) {
+            return;
+        }
+
+        std::vector< LoopAccess > accesses;
+        accesses.reserve( block.instructions.size() );
+        unsigned int written = 0;
+        bool readsDIV = false;
+        int hl = -1;
+        for ( size_t i = 0; i < block.instructions.size(); ++i ) {
+            const Instruction& instruction( block.instructions[ i ] );
+            LoopAccess access;
+            if ( !getLoopAccess( instruction, hl, access ) ) {
+                return;
+            }
+            if ( access.address >= 0 && !isIdleLoopInput( static_cast< unsigned short >( access.address ) ) ) {
+                return;
+            }
+            readsDIV |= access.address == kDIV;
+            if ( instruction.opcode == 0x21 ) {
+                hl = instruction.operands[ 0 ] | ( instruction.operands[ 1 ] << 8 );
+            }
+            else if ( access.writes & ( regBit( kRegH ) | regBit( kRegL ) ) ) {
+                hl = -1;
+            }
+            written |= access.writes;
+            accesses.push_back( access );
+        }
+
+        // Registers modified by the loop have to be written before being
+        // read, otherwise an iteration depends on the previous one.
+        unsigned int defined = 0;
+        for ( size_t i = 0; i < accesses.size(); ++i ) {
+            if ( ( accesses[ i ].reads & written & ~defined ) != 0 ) {
+                return;
+            }
+            defined |= accesses[ i ].writes;
+        }
+        const Instruction& jump( block.instructions.back() );
+        block.isIdleLoop = true;
+        block.idleLoopReadsDIV = readsDIV;
+        block.idleLoopCycles = block.cycles - jump.cycles + getOpcodeInfo( static_cast< Opcode >( jump.opcode ) ).takenCycles;
+    }
+
+    bool hasOpcodes(
+        const std::vector< Instruction >& instructions,
+        const size_t                      index,
+        const unsigned short* const       opcodes,
+        const size_t                      count
+    )
+    {
+        if ( instructions.size() - index < count ) {
+            return false;
+        }
+        for ( size_t i = 0; i < count; ++i ) {
+            if ( instructions[ index + i ].opcode != opcodes[ i ] ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns the sequence that starts at index, if any, and the number of
+    // instructions it spans.
+    FusedOp findFusion( const std::vector< Instruction >& instructions, const size_t index, size_t& count )
+    {
+        static const unsigned short kCopyLoop[] = { 0x2A, 0x12, 0x13, 0x0B, 0x78, 0xB1, 0x20 };
+        static const unsigned short kTestBC[] = { 0x78, 0xB1, 0x20 };
+
+        if ( hasOpcodes( instructions, index, kCopyLoop, 7 ) ) {
+            count = 7;
+            return kFusedCopyLoop;
+        }
+        if ( hasOpcodes( instructions, index, kTestBC, 3 ) ) {
+            count = 3;
+            return kFusedTestBC;
+        }
+        const size_t left = instructions.size() - index;
+        const unsigned short opcode = instructions[ index ].opcode;
+        if ( left >= 3 && opcode == 0xF0 &&
+             ( instructions[ index + 1 ].opcode == 0xE6 || instructions[ index + 1 ].opcode == 0xFE ) &&
+             ( instructions[ index + 2 ].opcode == 0x20 || instructions[ index + 2 ].opcode == 0x28 ) )
+        {
+            count = 3;
+            return kFusedPoll;
+        }
+        // DEC r, but not DEC (HL)
+        if ( left >= 2 && ( opcode & 0xC7 ) == 0x05 && opcode != 0x35 && instructions[ index + 1 ].opcode == 0x20 ) {
+            count = 2;
+            return kFusedCountdown;
+        }
+        count = 1;
+        return kNotFused;
+    }
+
+    void fuseInstructions( Block& block )
+    {
+        for ( size_t i = 0; i < block.instructions.size(); ) {
+            size_t count;
+            Instruction& first( block.instructions[ i ] );
+            first.fusion = static_cast< unsigned char >( findFusion( block.instructions, i, count ) );
+            first.fusedCount = static_cast< unsigned char >( count );
+            for ( size_t j = i; j < i + count - 1; ++j ) {
+                first.fusedLeadCycles += block.instructions[ j ].cycles;
+            }
+            i += count;
+        }
+    }
+}
+
+namespace gbemu {
+
+    int getInstructionLength( const unsigned char opcode )
+    {
+        return opcode == 0xCB ? 2 : getOpcodeInfo( static_cast< Opcode >( opcode ) ).length;
+    }
+
+    bool endsBlock( const unsigned char opcode )
+    {
+        switch( opcode ) {
+            // jumps
+            case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+            case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE9:
+            // calls and returns
+            case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC:
+            case 0xC0: case 0xC8: case 0xC9: case 0xD0: case 0xD8: case 0xD9:
+            case 0xC7: case 0xCF: case 0xD7: case 0xDF:
+            case 0xE7: case 0xEF: case 0xF7: case 0xFF:
+            // halt, stop and interrupts
+            case 0x76: case 0x10: case 0xF3: case 0xFB:
+            // undefined opcodes
+            case 0xD3: case 0xDB: case 0xDD: case 0xE3: case 0xE4:
+            case 0xEB: case 0xEC: case 0xED: case 0xF4: case 0xFC: case 0xFD:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    BlockCache::BlockCache(
+        Memory& memory
+    ) : _memory( memory ),
+        _block( nullptr ),
+        _index( 0 )
+    {
+        memset( _codePages, 0, sizeof( _codePages ) );
+    }
+
+    const Instruction* BlockCache::fetch( const unsigned short pc )
+    {
+        // Most of the time we are simply moving on to the next instruction
+        // of the block.
+        if ( continuesBlock( pc ) ) {
+            return &_block->instructions[ _index++ ];
+        }
+
+        _block = nullptr;
+
+        unsigned int key;
+        unsigned short regionEnd;
+        bool isRAM;
+        if ( !findRegion( pc, key, regionEnd, isRAM ) ) {
+            return nullptr;
+        }
+
+        BlockMap& blocks( isRAM ? _ramBlocks : _romBlocks );
+        BlockMap::const_iterator it = blocks.find( key );
+        if ( it != blocks.end() ) {
+            _block = it->second.get();
+        }
+        else {
+            std::unique_ptr< Block > block( buildBlock( pc, regionEnd ) );
+            if ( !block ) {
+                return nullptr;
+            }
+            block->isRAM = isRAM;
+            _block = block.get();
+            if ( isRAM ) {
+                addRAMBlock( key, std::move( block ) );
+            }
+            else {
+                _romBlocks[ key ] = std::move( block );
+            }
+        }
+        ++_block->executionCount;
+        _index = 1;
+        return &_block->instructions[ 0 ];
+    }
+
+    bool BlockCache::continuesBlock( const unsigned short pc ) const
+    {
+        return _block != nullptr &&
+               _index < _block->instructions.size() &&
+               _block->instructions[ _index ].addr == pc;
+    }
+
+    const Block* BlockCache::getCurrentBlock() const
+    {
+        return _block;
+    }
+
+    void BlockCache::skip( const size_t count )
+    {
+        _index += count;
+    }
+
+    void BlockCache::invalidate( const unsigned short addr )
+    {
+        if ( _codePages[ addr >> 8 ] == 0 ) {
+            return;
+        }
+        for ( BlockMap::iterator it = _ramBlocks.begin(); it != _ramBlocks.end(); ) {
+            const Block& block( *it->second );
+            if ( block.start <= addr && addr < block.end ) {
+                if ( _block == &block ) {
+                    _block = nullptr;
+                }
+                removeRAMBlock( block );
+                it = _ramBlocks.erase( it );
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    void BlockCache::resetCursor()
+    {
+        _block = nullptr;
+    }
+
+    bool BlockCache::findRegion(
+        const unsigned short pc,
+        unsigned int&        key,
+        unsigned short&      regionEnd,
+        bool&                isRAM
+    ) const
+    {
+        // The boot rom is only run once, don't bother caching it.
+        if ( _memory.isInBootRom( pc ) ) {
+            return false;
+        }
+        isRAM = false;
+        if ( Memory::isROMBank0( pc ) ) {
+            key = pc;
+            regionEnd = Memory::getSwitchableROMBankStart();
+        }
+        else if ( Memory::isSwitchableROMBank( pc ) ) {
+            key = ( static_cast< unsigned int >( _memory.getSwitchableROMBank() ) << 16 ) | pc;
+            regionEnd = 0x8000;
+        }
+        else if ( Memory::isInternalRAM( pc ) ) {
+            key = pc;
+            regionEnd = 0xE000;
+            isRAM = true;
+        }
+        else if ( Memory::isHighRAM( pc ) ) {
+            key = pc;
+            regionEnd = kIE;
+            isRAM = true;
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+
+    std::unique_ptr< Block > BlockCache::buildBlock(
+        const unsigned short pc,
+        const unsigned short regionEnd
+    ) const
+    {
+        std::unique_ptr< Block > block( new Block );
+        block->start = pc;
+        block->cycles = 0;
+        block->isRAM = false;
+        block->executionCount = 0;
+        block->isIdleLoop = false;
+        block->idleLoopReadsDIV = false;
+        block->idleLoopCycles = 0;
+
+        unsigned short addr = pc;
+        while ( block->instructions.size() < kMaxInstructionsPerBlock ) {
+            const unsigned char opcode = _memory.readByte( addr );
+            const int length = getInstructionLength( opcode );
+            // The instruction doesn't fit in this region, the CPU will have to
+            // decode it the slow way.
+            if ( addr + length > regionEnd ) {
+                break;
+            }
+
+            Instruction instruction;
+            instruction.addr = addr;
+            instruction.length = static_cast< unsigned char >( length );
+            instruction.operands[ 0 ] = 0;
+            instruction.operands[ 1 ] = 0;
+            instruction.fusion = kNotFused;
+            instruction.fusedCount = 1;
+            instruction.fusedLeadCycles = 0;
+            if ( opcode == 0xCB ) {
+                const unsigned char opcodeLow = _memory.readByte( addr + 1 );
+                instruction.opcode = static_cast< unsigned short >( opcode << 8 | opcodeLow );
+            }
+            else {
+                instruction.opcode = opcode;
+                for ( int i = 1; i < length; ++i ) {
+                    instruction.operands[ i - 1 ] = _memory.readByte( addr + i );
+                }
+            }
+
+            instruction.cycles = getOpcodeInfo( static_cast< Opcode >( instruction.opcode ) ).cycles;
+            block->instructions.push_back( instruction );
+            block->cycles += instruction.cycles;
+            addr += length;
+
+            if ( opcode != 0xCB && endsBlock( opcode ) ) {
+                break;
+            }
+        }
+
+        if ( block->instructions.empty() ) {
+            return std::unique_ptr< Block >();
+        }
+        block->end = addr;
+        analyzeIdleLoop( *block );
+        fuseInstructions( *block );
+        return block;
+    }
+
+    void BlockCache::addRAMBlock( const unsigned int key, std::unique_ptr< Block > block )
+    {
+        for ( int page = block->start >> 8; page <= ( block->end - 1 ) >> 8; ++page ) {
+            if ( _codePages[ page ]++ == 0 ) {
+                _memory.setCodePage( page, true );
+            }
+        }
+        _ramBlocks[ key ] = std::move( block );
+    }
+
+    void BlockCache::removeRAMBlock( const Block& block )
+    {
+        for ( int page = block.start >> 8; page <= ( block.end - 1 ) >> 8; ++page ) {
+            if ( --_codePages[ page ] == 0 ) {
+                _memory.setCodePage( page, false );
+            }
+        }
+    }
+}
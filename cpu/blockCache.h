@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cpu/opcode.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace gbemu {
+
+    class Memory;
+
+    // Frequent sequences of instructions that the CPU executes with a single
+    // handler. They all end on a JR Z or a JR NZ.
+    enum FusedOp
+    {
+        kNotFused,
+        // LD A,(HL+) / LD (DE),A / INC DE / DEC BC / LD A,B / OR C / JR NZ,n
+        kFusedCopyLoop,
+        // LDH A,(n) / AND n or CP n / JR Z,n or JR NZ,n
+        kFusedPoll,
+        // LD A,B / OR C / JR NZ,n
+        kFusedTestBC,
+        // DEC r / JR NZ,n
+        kFusedCountdown
+    };
+
+    // Size in bytes of the instruction starting with opcode, operands
+    // included.
+    int getInstructionLength( unsigned char opcode );
+    // Returns true if execution might not continue with the next instruction,
+    // either because of a jump, a change of interrupt state or an opcode the
+    // CPU can't execute.
+    bool endsBlock( unsigned char opcode );
+
+    // An instruction that has already been fetched from memory, with its
+    // operands and its cycle cost.
+    struct Instruction
+    {
+        unsigned short addr;
+        unsigned short opcode;
+        unsigned char  length;
+        unsigned char  cycles;
+        unsigned char  operands[ 2 ];
+        // Sequence starting at this instruction, how many instructions it
+        // spans and the cycles of all but the last one.
+        unsigned char  fusion;
+        unsigned char  fusedCount;
+        unsigned char  fusedLeadCycles;
+    };
+
+    // Straight-line run of instructions that ends on the first instruction
+    // that can change the flow of execution.
+    struct Block
+    {
+        unsigned short             start;
+        unsigned short             end;
+        int                        cycles;
+        bool                       isRAM;
+        // Number of times execution entered the block from its start.
+        unsigned int               executionCount;
+        // The block loops back to its start and only polls LY, STAT, IF, DIV
+        // or RAM. Each iteration computes the same registers from the same
+        // inputs, so iterations can be skipped until one of them changes.
+        bool                       isIdleLoop;
+        bool                       idleLoopReadsDIV;
+        // Cycles of an iteration, with the jump back taken.
+        int                        idleLoopCycles;
+        std::vector< Instruction > instructions;
+    };
+
+    // Caches predecoded blocks keyed by ROM bank and address so the CPU doesn't
+    // have to go through the memory map to decode instructions it has already
+    // seen. Blocks in WRAM and HRAM are dropped as soon as one of their bytes
+    // is written to.
+    class BlockCache
+    {
+    public:
+        BlockCache( Memory& memory );
+
+        // Returns the instruction at pc, or nullptr if the code at that
+        // address can't be cached.
+        const Instruction* fetch( unsigned short pc );
+        // Returns true if the next instruction fetched at pc comes from the
+        // block the last instruction was fetched from.
+        bool continuesBlock( unsigned short pc ) const;
+        // Block the last instruction was fetched from, if any.
+        const Block* getCurrentBlock() const;
+        // Moves past the instructions that were executed along with the last
+        // one fetched.
+        void skip( size_t count );
+        // Drops the RAM blocks that contain addr.
+        void invalidate( unsigned short addr );
+        // Forces the next fetch to look the block up again, for example
+        // after the ROM bank has been switched.
+        void resetCursor();
+
+    private:
+        BlockCache( const BlockCache& );
+        void operator=( const BlockCache& );
+
+        bool findRegion(
+            unsigned short  pc,
+            unsigned int&   key,
+            unsigned short& regionEnd,
+            bool&           isRAM
+        ) const;
+        std::unique_ptr< Block > buildBlock( unsigned short pc, unsigned short regionEnd ) const;
+        void addRAMBlock( unsigned int key, std::unique_ptr< Block > block );
+        void removeRAMBlock( const Block& block );
+
+        typedef std::unordered_map< unsigned int, std::unique_ptr< Block > > BlockMap;
+
+        Memory& _memory;
+
+        BlockMap _romBlocks;
+        BlockMap _ramBlocks;
+        // Number of RAM blocks overlapping each 256 bytes page. Memory only
+        // sends the writes to the pages with code to the cache.
+        unsigned short _codePages[ 256 ];
+
+        Block* _block;
+        size_t _index;
+    };
+}
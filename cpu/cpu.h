@@ -2,6 +2,10 @@
 
 #include <cpu/opcode.h>
 #include <cpu/registers.h>
+#include <cpu/blockCache.h>
+#ifdef GBEMU_PROFILER
+#include <cpu/profiler.h>
+#endif
 
 namespace gbemu {
 
@@ -12,6 +16,12 @@ namespace gbemu {
     {
     public:
 
+        // Interpreter executes one instruction per emulateCycle call.
+        // Blocks executes hot ROM blocks in one go, returning to the
+        // scheduler at the end of the block or when the cycle budget for the
+        // call runs out. Code in RAM and cold blocks are still interpreted.
+        enum class ExecutionMode { Interpreter, Blocks };
+
         CPU(
             Memory& memory,
             Cartridge& cartridge
@@ -19,31 +29,96 @@ namespace gbemu {
         Opcode previewOpcode() const;
         int previewInstructionTiming() const;
         int emulateCycle();
-        const Registers& getRegisters() const;
+        bool isHalted() const;
+        // Idle loop the CPU is about to run again, if any.
+        const Block* getIdleLoop() const;
+#ifdef GBEMU_PROFILER
+        Profiler& getProfiler();
+#endif
+        void setExecutionMode( ExecutionMode mode );
+        ExecutionMode getExecutionMode() const;
+        // Computes the pending flags first.
+        const Registers& getRegisters();
         bool areInterruptsEnabled() const;
         bool inBootRom() const;
 
         void executeInterrupt( unsigned short addr );
+        // Address of the instruction being executed and the cycles the
+        // current block ran before it.
+        unsigned short getInstructionPC() const;
+        int getInstructionCycles() const;
 
     private:
         void operator=( const CPU& cpu );
 
         enum InterruptState { kEnabled = 0, kDisabled = 1, kDisabledNextCycle = 2, kEnabledNextCycle = 3 };
 
+        // ALU operation the flags were last set by. kFlagsMaterialized means
+        // the flags in Registers are up to date.
+        enum FlagOp {
+            kFlagsMaterialized,
+            kFlagsAdd,
+            kFlagsSub,
+            kFlagsInc,
+            kFlagsDec,
+            kFlagsAnd,
+            kFlagsOr,
+            kFlagsAddWord
+        };
+
+        // A block needs to be entered this many times before it is executed
+        // in one go.
+        static const unsigned int kHotBlockThreshold = 16;
+        // Once that many cycles have been executed, return to the scheduler
+        // even if the block isn't over.
+        static const int kBlockCycleBudget = 64;
+
 
         Opcode decodeOpcode();
+        Opcode fetchOpcode();
         unsigned char readPCByte();
         char readPCSignedByte();
         unsigned short readPCWord();
         int execute( Opcode opcode );
+        // Fetches and executes the next instruction. blockCycles is the number
+        // of cycles run so far in the current block, or -1 when interpreting.
+        // In a hot ROM block, the instruction and the ones fused with it are
+        // executed together if the block would have run all of them before
+        // running out of its cycle budget.
+        int step( int blockCycles );
+        bool canExecuteFused( int blockCycles ) const;
+        int executeFused();
+        void enterFusedInstruction( const Instruction& instruction );
+        int executeBlock();
         void updateLCD( int nbCycles );
         void handleInterrupts();
 
+        // Operands of the register families, resolved at compile time so
+        // every opcode gets its own specialized handler. kMHL is the byte
+        // at HL.
+        template< ByteRegister R > unsigned char& reg();
+        template< ByteRegister R > unsigned char readReg();
+        template< ByteRegister R > void writeReg( unsigned char value );
+
+        template< ByteRegister Dst, ByteRegister Src > void ld_r_r();
+        template< ByteRegister R > void ld_r_n();
+        template< ByteRegister R > void inc_r();
+        template< ByteRegister R > void dec_r();
+        template< ByteRegister R > void rlc_r();
+        template< ByteRegister R > void rrc_r();
+        template< ByteRegister R > void rl_r();
+        template< ByteRegister R > void rr_r();
+        template< ByteRegister R > void sla_r();
+        template< ByteRegister R > void sra_r();
+        template< ByteRegister R > void swap_r();
+        template< ByteRegister R > void srl_r();
+        template< unsigned int Bit, ByteRegister R > void bit_b_r();
+        template< unsigned int Bit, ByteRegister R > void res_b_r();
+        template< unsigned int Bit, ByteRegister R > void set_b_r();
+
         void JP_nn() ;
         void XOR_n( const unsigned char value );
-        void ld_r_n( unsigned char& reg );
         void ld_r_nn( unsigned short& reg );
-        void ld_n_a( unsigned char& reg );
         void ld_nn_a( unsigned short addr );
         void ld_nn_sp();
         void ld_sp_hl();
@@ -62,21 +137,9 @@ namespace gbemu {
         void jp_hl();
         void jp_cc_nn( bool flag );
         void rrc_n( unsigned char& reg, bool zeroMaskFlag = true );
-        void rrc_mhl();
         void or_n( unsigned char value );
         void inc_n( unsigned char& value );
         void inc_nn( unsigned short& value );
-        void dec_MemoryHL();
-        void inc_MemoryHL();
-        void ld_r1_r2(
-            unsigned char& r1, unsigned char value
-        );
-        void ld_hl_r2( unsigned char value );
-        void bit_b_r( unsigned int index, unsigned char value );
-        void res_b_r( unsigned int index, unsigned char &value );
-        void res_b_mhl( unsigned int index );
-        void set_b_r( unsigned int index, unsigned char &value );
-        void set_b_mhl( unsigned int index );
         void ld_ff00_c_a();
         void ld_a_ff00_c();
         void call_nn();
@@ -87,19 +150,14 @@ namespace gbemu {
         void push_nn( unsigned short value );
         void pop_nn( unsigned short& value );
         void pop_af();
+        void push_af();
         void rr_n( unsigned char& value, bool zeroFlagMask = true );
-        void rr_hl();
         void rl_n( unsigned char& value, bool zeroFlagMask = true );
-        void rl_mhl();
         void rlc_n( unsigned char& value, bool zeroFlagMask = true );
         void rlca();
-        void rlc_mhl();
         void srl_n( unsigned char& reg );
-        void srl_mhl();
         void sla_n( unsigned char& value );
-        void sla_mhl();
         void sra_n( unsigned char& value );
-        void sra_mhl();
         void cp_n( unsigned char value );
         void and_n( unsigned char value );
         void cpl();
@@ -112,13 +170,28 @@ namespace gbemu {
         void di();
         void ei();
         void halt();
-        void swap_mhl();
         void swap_n( unsigned char& reg );
         void rst( unsigned short offset );
         void daa();
         void scf();
         void ccf();
 
+        // Records the operation that sets the flags. With GBEMU_LAZY_FLAGS
+        // they are only computed when an instruction reads them. carry is the
+        // carry in of ADC and SBC or the carry kept by INC and DEC, zero is
+        // the zero flag kept by ADD HL.
+        void setFlags(
+            FlagOp         op,
+            unsigned short left,
+            unsigned short right,
+            unsigned short result,
+            bool           carry,
+            bool           zero
+        );
+        void materializeFlags();
+        bool zeroFlag() const;
+        bool carryFlag() const;
+
         unsigned char subImp( unsigned char left, unsigned char right, bool carry = false );
         unsigned char addImp( unsigned char left, unsigned char right, bool carry = false );
         unsigned short addWordImp( unsigned short left, unsigned short right );
@@ -130,8 +203,30 @@ namespace gbemu {
         unsigned char _bootROM[ 256 ];
         InterruptState _interruptState;
 
-        unsigned char _opTime[ 256 ];
-        unsigned char _opTimeCb[ 256 ];
         bool _isHalted;
+        // Set by the conditional jumps, calls and returns.
+        bool _branchTaken;
+        unsigned short _instructionPC;
+        int _instructionCycles;
+
+        FlagOp         _flagOp;
+        unsigned short _flagLeft;
+        unsigned short _flagRight;
+        unsigned short _flagResult;
+        bool           _flagCarry;
+        bool           _flagZero;
+
+        ExecutionMode _executionMode;
+        BlockCache _blockCache;
+        // Copy of the instruction being executed when it comes from the block
+        // cache. Operands are read from it instead of memory.
+        Instruction          _instruction;
+        // Instruction in the block cache, so the ones fused with it can be
+        // found.
+        const Instruction*   _fetched;
+        const unsigned char* _operands;
+#ifdef GBEMU_PROFILER
+        Profiler             _profiler;
+#endif
     };
 }
@@ -1 +1,45 @@
 #include <cpu/opcode.h>
+#include <cctype>
+#include <cstdio>
+
+namespace gbemu {
+
+    constexpr OpcodeInfo OpcodeTables::kOpcodes[ 256 ];
+    constexpr OpcodeInfo OpcodeTables::kCbOpcodes[ 256 ];
+
+    std::string disassemble( const unsigned short addr, const unsigned char* const bytes )
+    {
+        const Opcode opcode = static_cast< Opcode >( bytes[ 0 ] == 0xCB ? 0xCB00 | bytes[ 1 ] : bytes[ 0 ] );
+        const OpcodeInfo& info( getOpcodeInfo( opcode ) );
+
+        char operand[ 16 ];
+        switch( info.operand ) {
+            case kOperandNone:
+                return info.mnemonic;
+            case kOperandByte:
+                snprintf( operand, sizeof( operand ), "$%02X", bytes[ 1 ] );
+                break;
+            case kOperandWord:
+                snprintf( operand, sizeof( operand ), "$%04X", bytes[ 1 ] | ( bytes[ 2 ] << 8 ) );
+                break;
+            case kOperandSignedByte:
+                snprintf( operand, sizeof( operand ), "%d", static_cast< signed char >( bytes[ 1 ] ) );
+                break;
+            case kOperandRelative:
+                snprintf( operand, sizeof( operand ), "$%04X", ( addr + info.length + static_cast< signed char >( bytes[ 1 ] ) ) & 0xFFFF );
+                break;
+        }
+
+        // The operand is the only lowercase word of the mnemonic.
+        std::string text( info.mnemonic );
+        size_t start = 0;
+        while ( start < text.size() && !islower( text[ start ] ) ) {
+            ++start;
+        }
+        size_t end = start;
+        while ( end < text.size() && islower( text[ end ] ) ) {
+            ++end;
+        }
+        return text.replace( start, end - start, operand );
+    }
+}
@@ -0,0 +1,529 @@
+// Every opcode of the CPU, in opcode order, with its metadata and its
+// handler. This file is included with GBEMU_OPCODE, GBEMU_CB_OPCODE and
+// GBEMU_UNDEFINED_OPCODE defined to generate the Opcode enum, the opcode
+// info tables and the dispatch of CPU::execute, so each opcode is only
+// described once.
+//
+// GBEMU_OPCODE( value, name, mnemonic, operand, cycles, takenCycles, flagsRead, flagsWritten, handler )
+// GBEMU_CB_OPCODE( value, name, mnemonic, cycles, flagsRead, flagsWritten, handler )
+// GBEMU_UNDEFINED_OPCODE( value )
+//
+// takenCycles is what a conditional jump, call or return costs when it is
+// taken. Flags are listed as ZNHC, with a - for the ones that are left alone.
+// Mnemonics name their operand n, nn or e.
+
+// Regular opcodes
+GBEMU_OPCODE( 0x00, kNop,        "NOP",          kOperandNone,        4,  4, "----", "----", )
+GBEMU_OPCODE( 0x01, LD_BC_nn,    "LD BC,nn",     kOperandWord,       12, 12, "----", "----", ld_r_nn( _BC.word ) )
+GBEMU_OPCODE( 0x02, LD_BC_A,     "LD (BC),A",    kOperandNone,        8,  8, "----", "----", ld_nn_a( _BC.word ) )
+GBEMU_OPCODE( 0x03, INC_BC,      "INC BC",       kOperandNone,        8,  8, "----", "----", inc_nn( _BC.word ) )
+GBEMU_OPCODE( 0x04, INC_B,       "INC B",        kOperandNone,        4,  4, "----", "Z0H-", inc_r< kB >() )
+GBEMU_OPCODE( 0x05, DEC_B,       "DEC B",        kOperandNone,        4,  4, "----", "Z1H-", dec_r< kB >() )
+GBEMU_OPCODE( 0x06, LD_B_n,      "LD B,n",       kOperandByte,        8,  8, "----", "----", ld_r_n< kB >() )
+GBEMU_OPCODE( 0x07, RLCA,        "RLCA",         kOperandNone,        4,  4, "----", "000C", rlc_n( _A, false ) )
+GBEMU_OPCODE( 0x08, LD_nn_SP,    "LD (nn),SP",   kOperandWord,       20, 20, "----", "----", ld_nn_sp() )
+GBEMU_OPCODE( 0x09, ADD_HL_BC,   "ADD HL,BC",    kOperandNone,        8,  8, "----", "-0HC", add_hl_n( _BC.word ) )
+GBEMU_OPCODE( 0x0A, LD_A_BC,     "LD A,(BC)",    kOperandNone,        8,  8, "----", "----", ld_a_n( _memory.readByte( _BC.word ) ) )
+GBEMU_OPCODE( 0x0B, DEC_BC,      "DEC BC",       kOperandNone,        8,  8, "----", "----", dec_nn( _BC.word ) )
+GBEMU_OPCODE( 0x0C, INC_C,       "INC C",        kOperandNone,        4,  4, "----", "Z0H-", inc_r< kC >() )
+GBEMU_OPCODE( 0x0D, DEC_C,       "DEC C",        kOperandNone,        4,  4, "----", "Z1H-", dec_r< kC >() )
+GBEMU_OPCODE( 0x0E, LD_C_n,      "LD C,n",       kOperandByte,        8,  8, "----", "----", ld_r_n< kC >() )
+GBEMU_OPCODE( 0x0F, RRCA,        "RRCA",         kOperandNone,        4,  4, "----", "000C", rrc_n( _A, false ) )
+GBEMU_UNDEFINED_OPCODE( 0x10 )
+GBEMU_OPCODE( 0x11, LD_DE_nn,    "LD DE,nn",     kOperandWord,       12, 12, "----", "----", ld_r_nn( _DE.word ) )
+GBEMU_OPCODE( 0x12, LD_DE_A,     "LD (DE),A",    kOperandNone,        8,  8, "----", "----", ld_nn_a( _DE.word ) )
+GBEMU_OPCODE( 0x13, INC_DE,      "INC DE",       kOperandNone,        8,  8, "----", "----", inc_nn( _DE.word ) )
+GBEMU_OPCODE( 0x14, INC_D,       "INC D",        kOperandNone,        4,  4, "----", "Z0H-", inc_r< kD >() )
+GBEMU_OPCODE( 0x15, DEC_D,       "DEC D",        kOperandNone,        4,  4, "----", "Z1H-", dec_r< kD >() )
+GBEMU_OPCODE( 0x16, LD_D_n,      "LD D,n",       kOperandByte,        8,  8, "----", "----", ld_r_n< kD >() )
+GBEMU_OPCODE( 0x17, RLA,         "RLA",          kOperandNone,        4,  4, "---C", "000C", rl_n( _A, false ) )
+GBEMU_OPCODE( 0x18, JR_n,        "JR e",         kOperandRelative,    8,  8, "----", "----", jr_n() )
+GBEMU_OPCODE( 0x19, ADD_HL_DE,   "ADD HL,DE",    kOperandNone,        8,  8, "----", "-0HC", add_hl_n( _DE.word ) )
+GBEMU_OPCODE( 0x1A, LD_A_DE,     "LD A,(DE)",    kOperandNone,        8,  8, "----", "----", ld_a_n( _memory.readByte( _DE.word ) ) )
+GBEMU_OPCODE( 0x1B, DEC_DE,      "DEC DE",       kOperandNone,        8,  8, "----", "----", dec_nn( _DE.word ) )
+GBEMU_OPCODE( 0x1C, INC_E,       "INC E",        kOperandNone,        4,  4, "----", "Z0H-", inc_r< kE >() )
+GBEMU_OPCODE( 0x1D, DEC_E,       "DEC E",        kOperandNone,        4,  4, "----", "Z1H-", dec_r< kE >() )
+GBEMU_OPCODE( 0x1E, LD_E_n,      "LD E,n",       kOperandByte,        8,  8, "----", "----", ld_r_n< kE >() )
+GBEMU_OPCODE( 0x1F, RRA,         "RRA",          kOperandNone,        4,  4, "---C", "000C", rr_n( _A, false ) )
+GBEMU_OPCODE( 0x20, JR_NZ_n,     "JR NZ,e",      kOperandRelative,    8, 12, "Z---", "----", jr_cc_n( !zeroFlag() ) )
+GBEMU_OPCODE( 0x21, LD_HL_nn,    "LD HL,nn",     kOperandWord,       12, 12, "----", "----", ld_r_nn( _HL.word ) )
+GBEMU_OPCODE( 0x22, LDI_HL_A,    "LD (HL+),A",   kOperandNone,        8,  8, "----", "----", ldi_hl_a() )
+GBEMU_OPCODE( 0x23, INC_HL,      "INC HL",       kOperandNone,        8,  8, "----", "----", inc_nn( _HL.word ) )
+GBEMU_OPCODE( 0x24, INC_H,       "INC H",        kOperandNone,        4,  4, "----", "Z0H-", inc_r< kH >() )
+GBEMU_OPCODE( 0x25, DEC_H,       "DEC H",        kOperandNone,        4,  4, "----", "Z1H-", dec_r< kH >() )
+GBEMU_OPCODE( 0x26, LD_H_n,      "LD H,n",       kOperandByte,        8,  8, "----", "----", ld_r_n< kH >() )
+GBEMU_OPCODE( 0x27, DAA,         "DAA",          kOperandNone,        4,  4, "-NHC", "Z-0C", daa() )
+GBEMU_OPCODE( 0x28, JR_Z_n,      "JR Z,e",       kOperandRelative,    8, 12, "Z---", "----", jr_cc_n( zeroFlag() ) )
+GBEMU_OPCODE( 0x29, ADD_HL_HL,   "ADD HL,HL",    kOperandNone,        8,  8, "----", "-0HC", add_hl_n( _HL.word ) )
+GBEMU_OPCODE( 0x2A, LDI_A_HL,    "LD A,(HL+)",   kOperandNone,        8,  8, "----", "----", ldi_a_hl() )
+GBEMU_OPCODE( 0x2B, DEC_HL,      "DEC HL",       kOperandNone,        8,  8, "----", "----", dec_nn( _HL.word ) )
+GBEMU_OPCODE( 0x2C, INC_L,       "INC L",        kOperandNone,        4,  4, "----", "Z0H-", inc_r< kL >() )
+GBEMU_OPCODE( 0x2D, DEC_L,       "DEC L",        kOperandNone,        4,  4, "----", "Z1H-", dec_r< kL >() )
+GBEMU_OPCODE( 0x2E, LD_L_n,      "LD L,n",       kOperandByte,        8,  8, "----", "----", ld_r_n< kL >() )
+GBEMU_OPCODE( 0x2F, CPL,         "CPL",          kOperandNone,        4,  4, "----", "-11-", cpl() )
+GBEMU_OPCODE( 0x30, JR_NC_n,     "JR NC,e",      kOperandRelative,    8, 12, "---C", "----", jr_cc_n( !carryFlag() ) )
+GBEMU_OPCODE( 0x31, LD_SP_nn,    "LD SP,nn",     kOperandWord,       12, 12, "----", "----", ld_r_nn( m_SP ) )
+GBEMU_OPCODE( 0x32, LDD_HL_A,    "LD (HL-),A",   kOperandNone,        8,  8, "----", "----", ldd_hl_a() )
+GBEMU_OPCODE( 0x33, INC_SP,      "INC SP",       kOperandNone,        8,  8, "----", "----", inc_nn( m_SP ) )
+GBEMU_OPCODE( 0x34, INC_MHL,     "INC (HL)",     kOperandNone,       12, 12, "----", "Z0H-", inc_r< kMHL >() )
+GBEMU_OPCODE( 0x35, DEC_MHL,     "DEC (HL)",     kOperandNone,       12, 12, "----", "Z1H-", dec_r< kMHL >() )
+GBEMU_OPCODE( 0x36, LD_HL_n,     "LD (HL),n",    kOperandByte,       12, 12, "----", "----", ld_r_n< kMHL >() )
+GBEMU_OPCODE( 0x37, SCF,         "SCF",          kOperandNone,        4,  4, "----", "-001", scf() )
+GBEMU_OPCODE( 0x38, JR_C_n,      "JR C,e",       kOperandRelative,    8, 12, "---C", "----", jr_cc_n( carryFlag() ) )
+GBEMU_OPCODE( 0x39, ADD_HL_SP,   "ADD HL,SP",    kOperandNone,        8,  8, "----", "-0HC", add_hl_n( m_SP ) )
+GBEMU_OPCODE( 0x3A, LDD_A_HL,    "LD A,(HL-)",   kOperandNone,        8,  8, "----", "----", ldd_a_hl() )
+GBEMU_OPCODE( 0x3B, DEC_SP,      "DEC SP",       kOperandNone,        8,  8, "----", "----", dec_nn( m_SP ) )
+GBEMU_OPCODE( 0x3C, INC_A,       "INC A",        kOperandNone,        4,  4, "----", "Z0H-", inc_r< kA >() )
+GBEMU_OPCODE( 0x3D, DEC_A,       "DEC A",        kOperandNone,        4,  4, "----", "Z1H-", dec_r< kA >() )
+GBEMU_OPCODE( 0x3E, LD_A_n,      "LD A,n",       kOperandByte,        8,  8, "----", "----", ld_r_n< kA >() )
+GBEMU_OPCODE( 0x3F, CCF,         "CCF",          kOperandNone,        4,  4, "---C", "-00C", ccf() )
+GBEMU_OPCODE( 0x40, LD_B_B,      "LD B,B",       kOperandNone,        4,  4, "----", "----", ld_r_r< kB, kB >() )
+GBEMU_OPCODE( 0x41, LD_B_C,      "LD B,C",       kOperandNone,        4,  4, "----", "----", ld_r_r< kB, kC >() )
+GBEMU_OPCODE( 0x42, LD_B_D,      "LD B,D",       kOperandNone,        4,  4, "----", "----", ld_r_r< kB, kD >() )
+GBEMU_OPCODE( 0x43, LD_B_E,      "LD B,E",       kOperandNone,        4,  4, "----", "----", ld_r_r< kB, kE >() )
+GBEMU_OPCODE( 0x44, LD_B_H,      "LD B,H",       kOperandNone,        4,  4, "----", "----", ld_r_r< kB, kH >() )
+GBEMU_OPCODE( 0x45, LD_B_L,      "LD B,L",       kOperandNone,        4,  4, "----", "----", ld_r_r< kB, kL >() )
+GBEMU_OPCODE( 0x46, LD_B_HL,     "LD B,(HL)",    kOperandNone,        8,  8, "----", "----", ld_r_r< kB, kMHL >() )
+GBEMU_OPCODE( 0x47, LD_B_A,      "LD B,A",       kOperandNone,        4,  4, "----", "----", ld_r_r< kB, kA >() )
+GBEMU_OPCODE( 0x48, LD_C_B,      "LD C,B",       kOperandNone,        4,  4, "----", "----", ld_r_r< kC, kB >() )
+GBEMU_OPCODE( 0x49, LD_C_C,      "LD C,C",       kOperandNone,        4,  4, "----", "----", ld_r_r< kC, kC >() )
+GBEMU_OPCODE( 0x4A, LD_C_D,      "LD C,D",       kOperandNone,        4,  4, "----", "----", ld_r_r< kC, kD >() )
+GBEMU_OPCODE( 0x4B, LD_C_E,      "LD C,E",       kOperandNone,        4,  4, "----", "----", ld_r_r< kC, kE >() )
+GBEMU_OPCODE( 0x4C, LD_C_H,      "LD C,H",       kOperandNone,        4,  4, "----", "----", ld_r_r< kC, kH >() )
+GBEMU_OPCODE( 0x4D, LD_C_L,      "LD C,L",       kOperandNone,        4,  4, "----", "----", ld_r_r< kC, kL >() )
+GBEMU_OPCODE( 0x4E, LD_C_HL,     "LD C,(HL)",    kOperandNone,        8,  8, "----", "----", ld_r_r< kC, kMHL >() )
+GBEMU_OPCODE( 0x4F, LD_C_A,      "LD C,A",       kOperandNone,        4,  4, "----", "----", ld_r_r< kC, kA >() )
+GBEMU_OPCODE( 0x50, LD_D_B,      "LD D,B",       kOperandNone,        4,  4, "----", "----", ld_r_r< kD, kB >() )
+GBEMU_OPCODE( 0x51, LD_D_C,      "LD D,C",       kOperandNone,        4,  4, "----", "----", ld_r_r< kD, kC >() )
+GBEMU_OPCODE( 0x52, LD_D_D,      "LD D,D",       kOperandNone,        4,  4, "----", "----", ld_r_r< kD, kD >() )
+GBEMU_OPCODE( 0x53, LD_D_E,      "LD D,E",       kOperandNone,        4,  4, "----", "----", ld_r_r< kD, kE >() )
+GBEMU_OPCODE( 0x54, LD_D_H,      "LD D,H",       kOperandNone,        4,  4, "----", "----", ld_r_r< kD, kH >() )
+GBEMU_OPCODE( 0x55, LD_D_L,      "LD D,L",       kOperandNone,        4,  4, "----", "----", ld_r_r< kD, kL >() )
+GBEMU_OPCODE( 0x56, LD_D_HL,     "LD D,(HL)",    kOperandNone,        8,  8, "----", "----", ld_r_r< kD, kMHL >() )
+GBEMU_OPCODE( 0x57, LD_D_A,      "LD D,A",       kOperandNone,        4,  4, "----", "----", ld_r_r< kD, kA >() )
+GBEMU_OPCODE( 0x58, LD_E_B,      "LD E,B",       kOperandNone,        4,  4, "----", "----", ld_r_r< kE, kB >() )
+GBEMU_OPCODE( 0x59, LD_E_C,      "LD E,C",       kOperandNone,        4,  4, "----", "----", ld_r_r< kE, kC >() )
+GBEMU_OPCODE( 0x5A, LD_E_D,      "LD E,D",       kOperandNone,        4,  4, "----", "----", ld_r_r< kE, kD >() )
+GBEMU_OPCODE( 0x5B, LD_E_E,      "LD E,E",       kOperandNone,        4,  4, "----", "----", ld_r_r< kE, kE >() )
+GBEMU_OPCODE( 0x5C, LD_E_H,      "LD E,H",       kOperandNone,        4,  4, "----", "----", ld_r_r< kE, kH >() )
+GBEMU_OPCODE( 0x5D, LD_E_L,      "LD E,L",       kOperandNone,        4,  4, "----", "----", ld_r_r< kE, kL >() )
+GBEMU_OPCODE( 0x5E, LD_E_HL,     "LD E,(HL)",    kOperandNone,        8,  8, "----", "----", ld_r_r< kE, kMHL >() )
+GBEMU_OPCODE( 0x5F, LD_E_A,      "LD E,A",       kOperandNone,        4,  4, "----", "----", ld_r_r< kE, kA >() )
+GBEMU_OPCODE( 0x60, LD_H_B,      "LD H,B",       kOperandNone,        4,  4, "----", "----", ld_r_r< kH, kB >() )
+GBEMU_OPCODE( 0x61, LD_H_C,      "LD H,C",       kOperandNone,        4,  4, "----", "----", ld_r_r< kH, kC >() )
+GBEMU_OPCODE( 0x62, LD_H_D,      "LD H,D",       kOperandNone,        4,  4, "----", "----", ld_r_r< kH, kD >() )
+GBEMU_OPCODE( 0x63, LD_H_E,      "LD H,E",       kOperandNone,        4,  4, "----", "----", ld_r_r< kH, kE >() )
+GBEMU_OPCODE( 0x64, LD_H_H,      "LD H,H",       kOperandNone,        4,  4, "----", "----", ld_r_r< kH, kH >() )
+GBEMU_OPCODE( 0x65, LD_H_L,      "LD H,L",       kOperandNone,        4,  4, "----", "----", ld_r_r< kH, kL >() )
+GBEMU_OPCODE( 0x66, LD_H_HL,     "LD H,(HL)",    kOperandNone,        8,  8, "----", "----", ld_r_r< kH, kMHL >() )
+GBEMU_OPCODE( 0x67, LD_H_A,      "LD H,A",       kOperandNone,        4,  4, "----", "----", ld_r_r< kH, kA >() )
+GBEMU_OPCODE( 0x68, LD_L_B,      "LD L,B",       kOperandNone,        4,  4, "----", "----", ld_r_r< kL, kB >() )
+GBEMU_OPCODE( 0x69, LD_L_C,      "LD L,C",       kOperandNone,        4,  4, "----", "----", ld_r_r< kL, kC >() )
+GBEMU_OPCODE( 0x6A, LD_L_D,      "LD L,D",       kOperandNone,        4,  4, "----", "----", ld_r_r< kL, kD >() )
+GBEMU_OPCODE( 0x6B, LD_L_E,      "LD L,E",       kOperandNone,        4,  4, "----", "----", ld_r_r< kL, kE >() )
+GBEMU_OPCODE( 0x6C, LD_L_H,      "LD L,H",       kOperandNone,        4,  4, "----", "----", ld_r_r< kL, kH >() )
+GBEMU_OPCODE( 0x6D, LD_L_L,      "LD L,L",       kOperandNone,        4,  4, "----", "----", ld_r_r< kL, kL >() )
+GBEMU_OPCODE( 0x6E, LD_L_HL,     "LD L,(HL)",    kOperandNone,        8,  8, "----", "----", ld_r_r< kL, kMHL >() )
+GBEMU_OPCODE( 0x6F, LD_L_A,      "LD L,A",       kOperandNone,        4,  4, "----", "----", ld_r_r< kL, kA >() )
+GBEMU_OPCODE( 0x70, LD_HL_B,     "LD (HL),B",    kOperandNone,        8,  8, "----", "----", ld_r_r< kMHL, kB >() )
+GBEMU_OPCODE( 0x71, LD_HL_C,     "LD (HL),C",    kOperandNone,        8,  8, "----", "----", ld_r_r< kMHL, kC >() )
+GBEMU_OPCODE( 0x72, LD_HL_D,     "LD (HL),D",    kOperandNone,        8,  8, "----", "----", ld_r_r< kMHL, kD >() )
+GBEMU_OPCODE( 0x73, LD_HL_E,     "LD (HL),E",    kOperandNone,        8,  8, "----", "----", ld_r_r< kMHL, kE >() )
+GBEMU_OPCODE( 0x74, LD_HL_H,     "LD (HL),H",    kOperandNone,        8,  8, "----", "----", ld_r_r< kMHL, kH >() )
+GBEMU_OPCODE( 0x75, LD_HL_L,     "LD (HL),L",    kOperandNone,        8,  8, "----", "----", ld_r_r< kMHL, kL >() )
+GBEMU_OPCODE( 0x76, HALT,        "HALT",         kOperandNone,        4,  4, "----", "----", halt() )
+GBEMU_OPCODE( 0x77, LD_HL_A,     "LD (HL),A",    kOperandNone,        8,  8, "----", "----", ld_r_r< kMHL, kA >() )
+GBEMU_OPCODE( 0x78, LD_A_B,      "LD A,B",       kOperandNone,        4,  4, "----", "----", ld_r_r< kA, kB >() )
+GBEMU_OPCODE( 0x79, LD_A_C,      "LD A,C",       kOperandNone,        4,  4, "----", "----", ld_r_r< kA, kC >() )
+GBEMU_OPCODE( 0x7A, LD_A_D,      "LD A,D",       kOperandNone,        4,  4, "----", "----", ld_r_r< kA, kD >() )
+GBEMU_OPCODE( 0x7B, LD_A_E,      "LD A,E",       kOperandNone,        4,  4, "----", "----", ld_r_r< kA, kE >() )
+GBEMU_OPCODE( 0x7C, LD_A_H,      "LD A,H",       kOperandNone,        4,  4, "----", "----", ld_r_r< kA, kH >() )
+GBEMU_OPCODE( 0x7D, LD_A_L,      "LD A,L",       kOperandNone,        4,  4, "----", "----", ld_r_r< kA, kL >() )
+GBEMU_OPCODE( 0x7E, LD_A_HL,     "LD A,(HL)",    kOperandNone,        8,  8, "----", "----", ld_r_r< kA, kMHL >() )
+GBEMU_OPCODE( 0x7F, LD_A_A,      "LD A,A",       kOperandNone,        4,  4, "----", "----", ld_r_r< kA, kA >() )
+GBEMU_OPCODE( 0x80, ADD_B,       "ADD A,B",      kOperandNone,        4,  4, "----", "Z0HC", add_n( readReg< kB >() ) )
+GBEMU_OPCODE( 0x81, ADD_C,       "ADD A,C",      kOperandNone,        4,  4, "----", "Z0HC", add_n( readReg< kC >() ) )
+GBEMU_OPCODE( 0x82, ADD_D,       "ADD A,D",      kOperandNone,        4,  4, "----", "Z0HC", add_n( readReg< kD >() ) )
+GBEMU_OPCODE( 0x83, ADD_E,       "ADD A,E",      kOperandNone,        4,  4, "----", "Z0HC", add_n( readReg< kE >() ) )
+GBEMU_OPCODE( 0x84, ADD_H,       "ADD A,H",      kOperandNone,        4,  4, "----", "Z0HC", add_n( readReg< kH >() ) )
+GBEMU_OPCODE( 0x85, ADD_L,       "ADD A,L",      kOperandNone,        4,  4, "----", "Z0HC", add_n( readReg< kL >() ) )
+GBEMU_OPCODE( 0x86, ADD_MHL,     "ADD A,(HL)",   kOperandNone,        8,  8, "----", "Z0HC", add_n( readReg< kMHL >() ) )
+GBEMU_OPCODE( 0x87, ADD_A,       "ADD A,A",      kOperandNone,        4,  4, "----", "Z0HC", add_n( readReg< kA >() ) )
+GBEMU_OPCODE( 0x88, ACD_A_B,     "ADC A,B",      kOperandNone,        4,  4, "---C", "Z0HC", adc_a_n( readReg< kB >() ) )
+GBEMU_OPCODE( 0x89, ACD_A_C,     "ADC A,C",      kOperandNone,        4,  4, "---C", "Z0HC", adc_a_n( readReg< kC >() ) )
+GBEMU_OPCODE( 0x8A, ACD_A_D,     "ADC A,D",      kOperandNone,        4,  4, "---C", "Z0HC", adc_a_n( readReg< kD >() ) )
+GBEMU_OPCODE( 0x8B, ACD_A_E,     "ADC A,E",      kOperandNone,        4,  4, "---C", "Z0HC", adc_a_n( readReg< kE >() ) )
+GBEMU_OPCODE( 0x8C, ACD_A_H,     "ADC A,H",      kOperandNone,        4,  4, "---C", "Z0HC", adc_a_n( readReg< kH >() ) )
+GBEMU_OPCODE( 0x8D, ACD_A_L,     "ADC A,L",      kOperandNone,        4,  4, "---C", "Z0HC", adc_a_n( readReg< kL >() ) )
+GBEMU_OPCODE( 0x8E, ACD_A_MHL,   "ADC A,(HL)",   kOperandNone,        8,  8, "---C", "Z0HC", adc_a_n( readReg< kMHL >() ) )
+GBEMU_OPCODE( 0x8F, ACD_A_A,     "ADC A,A",      kOperandNone,        4,  4, "---C", "Z0HC", adc_a_n( readReg< kA >() ) )
+GBEMU_OPCODE( 0x90, SUB_B,       "SUB B",        kOperandNone,        4,  4, "----", "Z1HC", sub_n( readReg< kB >() ) )
+GBEMU_OPCODE( 0x91, SUB_C,       "SUB C",        kOperandNone,        4,  4, "----", "Z1HC", sub_n( readReg< kC >() ) )
+GBEMU_OPCODE( 0x92, SUB_D,       "SUB D",        kOperandNone,        4,  4, "----", "Z1HC", sub_n( readReg< kD >() ) )
+GBEMU_OPCODE( 0x93, SUB_E,       "SUB E",        kOperandNone,        4,  4, "----", "Z1HC", sub_n( readReg< kE >() ) )
+GBEMU_OPCODE( 0x94, SUB_H,       "SUB H",        kOperandNone,        4,  4, "----", "Z1HC", sub_n( readReg< kH >() ) )
+GBEMU_OPCODE( 0x95, SUB_L,       "SUB L",        kOperandNone,        4,  4, "----", "Z1HC", sub_n( readReg< kL >() ) )
+GBEMU_OPCODE( 0x96, SUB_MHL,     "SUB (HL)",     kOperandNone,        8,  8, "----", "Z1HC", sub_n( readReg< kMHL >() ) )
+GBEMU_OPCODE( 0x97, SUB_A,       "SUB A",        kOperandNone,        4,  4, "----", "Z1HC", sub_n( readReg< kA >() ) )
+GBEMU_OPCODE( 0x98, SBC_A_B,     "SBC A,B",      kOperandNone,        4,  4, "---C", "Z1HC", sbc_a_n( readReg< kB >() ) )
+GBEMU_OPCODE( 0x99, SBC_A_C,     "SBC A,C",      kOperandNone,        4,  4, "---C", "Z1HC", sbc_a_n( readReg< kC >() ) )
+GBEMU_OPCODE( 0x9A, SBC_A_D,     "SBC A,D",      kOperandNone,        4,  4, "---C", "Z1HC", sbc_a_n( readReg< kD >() ) )
+GBEMU_OPCODE( 0x9B, SBC_A_E,     "SBC A,E",      kOperandNone,        4,  4, "---C", "Z1HC", sbc_a_n( readReg< kE >() ) )
+GBEMU_OPCODE( 0x9C, SBC_A_H,     "SBC A,H",      kOperandNone,        4,  4, "---C", "Z1HC", sbc_a_n( readReg< kH >() ) )
+GBEMU_OPCODE( 0x9D, SBC_A_L,     "SBC A,L",      kOperandNone,        4,  4, "---C", "Z1HC", sbc_a_n( readReg< kL >() ) )
+GBEMU_OPCODE( 0x9E, SBC_A_MHL,   "SBC A,(HL)",   kOperandNone,        8,  8, "---C", "Z1HC", sbc_a_n( readReg< kMHL >() ) )
+GBEMU_OPCODE( 0x9F, SBC_A_A,     "SBC A,A",      kOperandNone,        4,  4, "---C", "Z1HC", sbc_a_n( readReg< kA >() ) )
+GBEMU_OPCODE( 0xA0, AND_B,       "AND B",        kOperandNone,        4,  4, "----", "Z010", and_n( readReg< kB >() ) )
+GBEMU_OPCODE( 0xA1, AND_C,       "AND C",        kOperandNone,        4,  4, "----", "Z010", and_n( readReg< kC >() ) )
+GBEMU_OPCODE( 0xA2, AND_D,       "AND D",        kOperandNone,        4,  4, "----", "Z010", and_n( readReg< kD >() ) )
+GBEMU_OPCODE( 0xA3, AND_E,       "AND E",        kOperandNone,        4,  4, "----", "Z010", and_n( readReg< kE >() ) )
+GBEMU_OPCODE( 0xA4, AND_H,       "AND H",        kOperandNone,        4,  4, "----", "Z010", and_n( readReg< kH >() ) )
+GBEMU_OPCODE( 0xA5, AND_L,       "AND L",        kOperandNone,        4,  4, "----", "Z010", and_n( readReg< kL >() ) )
+GBEMU_OPCODE( 0xA6, AND_MHL,     "AND (HL)",     kOperandNone,        8,  8, "----", "Z010", and_n( readReg< kMHL >() ) )
+GBEMU_OPCODE( 0xA7, AND_A,       "AND A",        kOperandNone,        4,  4, "----", "Z010", and_n( readReg< kA >() ) )
+GBEMU_OPCODE( 0xA8, kXOR_B,      "XOR B",        kOperandNone,        4,  4, "----", "Z000", XOR_n( readReg< kB >() ) )
+GBEMU_OPCODE( 0xA9, kXOR_C,      "XOR C",        kOperandNone,        4,  4, "----", "Z000", XOR_n( readReg< kC >() ) )
+GBEMU_OPCODE( 0xAA, kXOR_D,      "XOR D",        kOperandNone,        4,  4, "----", "Z000", XOR_n( readReg< kD >() ) )
+GBEMU_OPCODE( 0xAB, kXOR_E,      "XOR E",        kOperandNone,        4,  4, "----", "Z000", XOR_n( readReg< kE >() ) )
+GBEMU_OPCODE( 0xAC, kXOR_H,      "XOR H",        kOperandNone,        4,  4, "----", "Z000", XOR_n( readReg< kH >() ) )
+GBEMU_OPCODE( 0xAD, kXOR_L,      "XOR L",        kOperandNone,        4,  4, "----", "Z000", XOR_n( readReg< kL >() ) )
+GBEMU_OPCODE( 0xAE, kXOR_HL,     "XOR (HL)",     kOperandNone,        8,  8, "----", "Z000", XOR_n( readReg< kMHL >() ) )
+GBEMU_OPCODE( 0xAF, kXOR_A,      "XOR A",        kOperandNone,        4,  4, "----", "Z000", XOR_n( readReg< kA >() ) )
+GBEMU_OPCODE( 0xB0, OR_B,        "OR B",         kOperandNone,        4,  4, "----", "Z000", or_n( readReg< kB >() ) )
+GBEMU_OPCODE( 0xB1, OR_C,        "OR C",         kOperandNone,        4,  4, "----", "Z000", or_n( readReg< kC >() ) )
+GBEMU_OPCODE( 0xB2, OR_D,        "OR D",         kOperandNone,        4,  4, "----", "Z000", or_n( readReg< kD >() ) )
+GBEMU_OPCODE( 0xB3, OR_E,        "OR E",         kOperandNone,        4,  4, "----", "Z000", or_n( readReg< kE >() ) )
+GBEMU_OPCODE( 0xB4, OR_H,        "OR H",         kOperandNone,        4,  4, "----", "Z000", or_n( readReg< kH >() ) )
+GBEMU_OPCODE( 0xB5, OR_L,        "OR L",         kOperandNone,        4,  4, "----", "Z000", or_n( readReg< kL >() ) )
+GBEMU_OPCODE( 0xB6, OR_HL,       "OR (HL)",      kOperandNone,        8,  8, "----", "Z000", or_n( readReg< kMHL >() ) )
+GBEMU_OPCODE( 0xB7, OR_A,        "OR A",         kOperandNone,        4,  4, "----", "Z000", or_n( readReg< kA >() ) )
+GBEMU_OPCODE( 0xB8, CP_B,        "CP B",         kOperandNone,        4,  4, "----", "Z1HC", cp_n( readReg< kB >() ) )
+GBEMU_OPCODE( 0xB9, CP_C,        "CP C",         kOperandNone,        4,  4, "----", "Z1HC", cp_n( readReg< kC >() ) )
+GBEMU_OPCODE( 0xBA, CP_D,        "CP D",         kOperandNone,        4,  4, "----", "Z1HC", cp_n( readReg< kD >() ) )
+GBEMU_OPCODE( 0xBB, CP_E,        "CP E",         kOperandNone,        4,  4, "----", "Z1HC", cp_n( readReg< kE >() ) )
+GBEMU_OPCODE( 0xBC, CP_H,        "CP H",         kOperandNone,        4,  4, "----", "Z1HC", cp_n( readReg< kH >() ) )
+GBEMU_OPCODE( 0xBD, CP_L,        "CP L",         kOperandNone,        4,  4, "----", "Z1HC", cp_n( readReg< kL >() ) )
+GBEMU_OPCODE( 0xBE, CP_HL,       "CP (HL)",      kOperandNone,        8,  8, "----", "Z1HC", cp_n( readReg< kMHL >() ) )
+GBEMU_OPCODE( 0xBF, CP_A,        "CP A",         kOperandNone,        4,  4, "----", "Z1HC", cp_n( readReg< kA >() ) )
+GBEMU_OPCODE( 0xC0, RET_NZ,      "RET NZ",       kOperandNone,        8, 20, "Z---", "----", ret_cc( !zeroFlag() ) )
+GBEMU_OPCODE( 0xC1, POP_BC,      "POP BC",       kOperandNone,       12, 12, "----", "----", pop_nn( _BC.word ) )
+GBEMU_OPCODE( 0xC2, JP_NZ_nn,    "JP NZ,nn",     kOperandWord,       12, 16, "Z---", "----", jp_cc_nn( !zeroFlag() ) )
+GBEMU_OPCODE( 0xC3, kJP,         "JP nn",        kOperandWord,       12, 12, "----", "----", JP_nn() )
+GBEMU_OPCODE( 0xC4, CALL_NZ_nn,  "CALL NZ,nn",   kOperandWord,       12, 24, "Z---", "----", call_cc_nn( !zeroFlag() ) )
+GBEMU_OPCODE( 0xC5, PUSH_BC,     "PUSH BC",      kOperandNone,       16, 16, "----", "----", push_nn( _BC.word ) )
+GBEMU_OPCODE( 0xC6, ADD_N,       "ADD A,n",      kOperandByte,        8,  8, "----", "Z0HC", add_n( readPCByte() ) )
+GBEMU_OPCODE( 0xC7, RST_00,      "RST 00H",      kOperandNone,       32, 32, "----", "----", rst( 0x00 ) )
+GBEMU_OPCODE( 0xC8, RET_Z,       "RET Z",        kOperandNone,        8, 20, "Z---", "----", ret_cc( zeroFlag() ) )
+GBEMU_OPCODE( 0xC9, RET,         "RET",          kOperandNone,        8,  8, "----", "----", ret() )
+GBEMU_OPCODE( 0xCA, JP_Z_nn,     "JP Z,nn",      kOperandWord,       12, 16, "Z---", "----", jp_cc_nn( zeroFlag() ) )
+GBEMU_UNDEFINED_OPCODE( 0xCB ) // Prefix of the CB opcodes, never dispatched.
+GBEMU_OPCODE( 0xCC, CALL_Z_nn,   "CALL Z,nn",    kOperandWord,       12, 24, "Z---", "----", call_cc_nn( zeroFlag() ) )
+GBEMU_OPCODE( 0xCD, CALL_nn,     "CALL nn",      kOperandWord,       12, 12, "----", "----", call_nn() )
+GBEMU_OPCODE( 0xCE, ACD_A_MPC,   "ADC A,n",      kOperandByte,        8,  8, "---C", "Z0HC", adc_a_n( readPCByte() ) )
+GBEMU_OPCODE( 0xCF, RST_08,      "RST 08H",      kOperandNone,       32, 32, "----", "----", rst( 0x08 ) )
+GBEMU_OPCODE( 0xD0, RET_NC,      "RET NC",       kOperandNone,        8, 20, "---C", "----", ret_cc( !carryFlag() ) )
+GBEMU_OPCODE( 0xD1, POP_DE,      "POP DE",       kOperandNone,       12, 12, "----", "----", pop_nn( _DE.word ) )
+GBEMU_OPCODE( 0xD2, JP_NC_nn,    "JP NC,nn",     kOperandWord,       12, 16, "---C", "----", jp_cc_nn( !carryFlag() ) )
+GBEMU_UNDEFINED_OPCODE( 0xD3 )
+GBEMU_OPCODE( 0xD4, CALL_NC_nn,  "CALL NC,nn",   kOperandWord,       12, 24, "---C", "----", call_cc_nn( !carryFlag() ) )
+GBEMU_OPCODE( 0xD5, PUSH_DE,     "PUSH DE",      kOperandNone,       16, 16, "----", "----", push_nn( _DE.word ) )
+GBEMU_OPCODE( 0xD6, SUB_N,       "SUB n",        kOperandByte,        8,  8, "----", "Z1HC", sub_n( readPCByte() ) )
+GBEMU_OPCODE( 0xD7, RST_10,      "RST 10H",      kOperandNone,       32, 32, "----", "----", rst( 0x10 ) )
+GBEMU_OPCODE( 0xD8, RET_C,       "RET C",        kOperandNone,        8, 20, "---C", "----", ret_cc( carryFlag() ) )
+GBEMU_OPCODE( 0xD9, RETI,        "RETI",         kOperandNone,        8,  8, "----", "----", reti() )
+GBEMU_OPCODE( 0xDA, JP_C_nn,     "JP C,nn",      kOperandWord,       12, 16, "---C", "----", jp_cc_nn( carryFlag() ) )
+GBEMU_UNDEFINED_OPCODE( 0xDB )
+GBEMU_OPCODE( 0xDC, CALL_C_nn,   "CALL C,nn",    kOperandWord,       12, 24, "---C", "----", call_cc_nn( carryFlag() ) )
+GBEMU_UNDEFINED_OPCODE( 0xDD )
+GBEMU_OPCODE( 0xDE, SBC_A_n,     "SBC A,n",      kOperandByte,        4,  4, "---C", "Z1HC", sbc_a_n( readPCByte() ) )
+GBEMU_OPCODE( 0xDF, RST_18,      "RST 18H",      kOperandNone,       32, 32, "----", "----", rst( 0x18 ) )
+GBEMU_OPCODE( 0xE0, LDH_n_A,     "LDH (n),A",    kOperandByte,       12, 12, "----", "----", ldh_n_a() )
+GBEMU_OPCODE( 0xE1, POP_HL,      "POP HL",       kOperandNone,       12, 12, "----", "----", pop_nn( _HL.word ) )
+GBEMU_OPCODE( 0xE2, LD_FF00_C_A, "LD (C),A",     kOperandNone,        8,  8, "----", "----", ld_ff00_c_a( ) )
+GBEMU_UNDEFINED_OPCODE( 0xE3 )
+GBEMU_UNDEFINED_OPCODE( 0xE4 )
+GBEMU_OPCODE( 0xE5, PUSH_HL,     "PUSH HL",      kOperandNone,       16, 16, "----", "----", push_nn( _HL.word ) )
+GBEMU_OPCODE( 0xE6, AND_PC,      "AND n",        kOperandByte,        8,  8, "----", "Z010", and_n( readPCByte() ) )
+GBEMU_OPCODE( 0xE7, RST_20,      "RST 20H",      kOperandNone,       32, 32, "----", "----", rst( 0x20 ) )
+GBEMU_OPCODE( 0xE8, ADD_SP_n,    "ADD SP,e",     kOperandSignedByte, 16, 16, "----", "00HC", add_sp_n() )
+GBEMU_OPCODE( 0xE9, JP_MHL,      "JP (HL)",      kOperandNone,        4,  4, "----", "----", jp_hl() )
+GBEMU_OPCODE( 0xEA, LD_nn_A,     "LD (nn),A",    kOperandWord,       16, 16, "----", "----", ld_nn_a( readPCWord() ) )
+GBEMU_UNDEFINED_OPCODE( 0xEB )
+GBEMU_UNDEFINED_OPCODE( 0xEC )
+GBEMU_UNDEFINED_OPCODE( 0xED )
+GBEMU_OPCODE( 0xEE, kXOR_STAR,   "XOR n",        kOperandByte,        8,  8, "----", "Z000", XOR_n( readPCByte() ) )
+GBEMU_OPCODE( 0xEF, RST_28,      "RST 28H",      kOperandNone,       32, 32, "----", "----", rst( 0x28 ) )
+GBEMU_OPCODE( 0xF0, LDH_A_n,     "LDH A,(n)",    kOperandByte,       12, 12, "----", "----", ldh_a_n() )
+GBEMU_OPCODE( 0xF1, POP_AF,      "POP AF",       kOperandNone,       12, 12, "----", "ZNHC", pop_af() )
+GBEMU_OPCODE( 0xF2, LD_A_FF00_C, "LD A,(C)",     kOperandNone,        8,  8, "----", "----", ld_a_ff00_c() )
+GBEMU_OPCODE( 0xF3, DI,          "DI",           kOperandNone,        4,  4, "----", "----", di() )
+GBEMU_UNDEFINED_OPCODE( 0xF4 )
+GBEMU_OPCODE( 0xF5, PUSH_AF,     "PUSH AF",      kOperandNone,       16, 16, "ZNHC", "----", push_af() )
+GBEMU_OPCODE( 0xF6, OR_STAR,     "OR n",         kOperandByte,        8,  8, "----", "Z000", or_n( readPCByte() ) )
+GBEMU_OPCODE( 0xF7, RST_30,      "RST 30H",      kOperandNone,       32, 32, "----", "----", rst( 0x30 ) )
+GBEMU_OPCODE( 0xF8, LD_HL_SP_n,  "LD HL,SP+e",   kOperandSignedByte, 12, 12, "----", "00HC", ld_hl_sp_n() )
+GBEMU_OPCODE( 0xF9, LD_SP_HL,    "LD SP,HL",     kOperandNone,        8,  8, "----", "----", ld_sp_hl() )
+GBEMU_OPCODE( 0xFA, LD_A_nn,     "LD A,(nn)",    kOperandWord,       16, 16, "----", "----", ld_a_n( _memory.readByte( readPCWord() ) ) )
+GBEMU_OPCODE( 0xFB, EI,          "EI",           kOperandNone,        4,  4, "----", "----", ei() )
+GBEMU_UNDEFINED_OPCODE( 0xFC )
+GBEMU_UNDEFINED_OPCODE( 0xFD )
+GBEMU_OPCODE( 0xFE, CP_N,        "CP n",         kOperandByte,        8,  8, "----", "Z1HC", cp_n( readPCByte() ) )
+GBEMU_OPCODE( 0xFF, RST_38,      "RST 38H",      kOperandNone,       32, 32, "----", "----", rst( 0x38 ) )
+
+// CB prefixed opcodes
+GBEMU_CB_OPCODE( 0x00, RLC_B,       "RLC B",         8, "----", "Z00C", rlc_r< kB >() )
+GBEMU_CB_OPCODE( 0x01, RLC_C,       "RLC C",         8, "----", "Z00C", rlc_r< kC >() )
+GBEMU_CB_OPCODE( 0x02, RLC_D,       "RLC D",         8, "----", "Z00C", rlc_r< kD >() )
+GBEMU_CB_OPCODE( 0x03, RLC_E,       "RLC E",         8, "----", "Z00C", rlc_r< kE >() )
+GBEMU_CB_OPCODE( 0x04, RLC_H,       "RLC H",         8, "----", "Z00C", rlc_r< kH >() )
+GBEMU_CB_OPCODE( 0x05, RLC_L,       "RLC L",         8, "----", "Z00C", rlc_r< kL >() )
+GBEMU_CB_OPCODE( 0x06, RLC_MHL,     "RLC (HL)",     16, "----", "Z00C", rlc_r< kMHL >() )
+GBEMU_CB_OPCODE( 0x07, RLC_A,       "RLC A",         8, "----", "Z00C", rlc_r< kA >() )
+GBEMU_CB_OPCODE( 0x08, RRC_B,       "RRC B",         8, "----", "Z00C", rrc_r< kB >() )
+GBEMU_CB_OPCODE( 0x09, RRC_C,       "RRC C",         8, "----", "Z00C", rrc_r< kC >() )
+GBEMU_CB_OPCODE( 0x0A, RRC_D,       "RRC D",         8, "----", "Z00C", rrc_r< kD >() )
+GBEMU_CB_OPCODE( 0x0B, RRC_E,       "RRC E",         8, "----", "Z00C", rrc_r< kE >() )
+GBEMU_CB_OPCODE( 0x0C, RRC_H,       "RRC H",         8, "----", "Z00C", rrc_r< kH >() )
+GBEMU_CB_OPCODE( 0x0D, RRC_L,       "RRC L",         8, "----", "Z00C", rrc_r< kL >() )
+GBEMU_CB_OPCODE( 0x0E, RRC_MHL,     "RRC (HL)",     16, "----", "Z00C", rrc_r< kMHL >() )
+GBEMU_CB_OPCODE( 0x0F, RRC_A,       "RRC A",         8, "----", "Z00C", rrc_r< kA >() )
+GBEMU_CB_OPCODE( 0x10, RL_B,        "RL B",          8, "---C", "Z00C", rl_r< kB >() )
+GBEMU_CB_OPCODE( 0x11, RL_C,        "RL C",          8, "---C", "Z00C", rl_r< kC >() )
+GBEMU_CB_OPCODE( 0x12, RL_D,        "RL D",          8, "---C", "Z00C", rl_r< kD >() )
+GBEMU_CB_OPCODE( 0x13, RL_E,        "RL E",          8, "---C", "Z00C", rl_r< kE >() )
+GBEMU_CB_OPCODE( 0x14, RL_H,        "RL H",          8, "---C", "Z00C", rl_r< kH >() )
+GBEMU_CB_OPCODE( 0x15, RL_L,        "RL L",          8, "---C", "Z00C", rl_r< kL >() )
+GBEMU_CB_OPCODE( 0x16, RL_HL,       "RL (HL)",      16, "---C", "Z00C", rl_r< kMHL >() )
+GBEMU_CB_OPCODE( 0x17, RL_A,        "RL A",          8, "---C", "Z00C", rl_r< kA >() )
+GBEMU_CB_OPCODE( 0x18, RR_B,        "RR B",          8, "---C", "Z00C", rr_r< kB >() )
+GBEMU_CB_OPCODE( 0x19, RR_C,        "RR C",          8, "---C", "Z00C", rr_r< kC >() )
+GBEMU_CB_OPCODE( 0x1A, RR_D,        "RR D",          8, "---C", "Z00C", rr_r< kD >() )
+GBEMU_CB_OPCODE( 0x1B, RR_E,        "RR E",          8, "---C", "Z00C", rr_r< kE >() )
+GBEMU_CB_OPCODE( 0x1C, RR_H,        "RR H",          8, "---C", "Z00C", rr_r< kH >() )
+GBEMU_CB_OPCODE( 0x1D, RR_L,        "RR L",          8, "---C", "Z00C", rr_r< kL >() )
+GBEMU_CB_OPCODE( 0x1E, RR_HL,       "RR (HL)",      16, "---C", "Z00C", rr_r< kMHL >() )
+GBEMU_CB_OPCODE( 0x1F, RR_A,        "RR A",          8, "---C", "Z00C", rr_r< kA >() )
+GBEMU_CB_OPCODE( 0x20, SLA_B,       "SLA B",         8, "----", "Z00C", sla_r< kB >() )
+GBEMU_CB_OPCODE( 0x21, SLA_C,       "SLA C",         8, "----", "Z00C", sla_r< kC >() )
+GBEMU_CB_OPCODE( 0x22, SLA_D,       "SLA D",         8, "----", "Z00C", sla_r< kD >() )
+GBEMU_CB_OPCODE( 0x23, SLA_E,       "SLA E",         8, "----", "Z00C", sla_r< kE >() )
+GBEMU_CB_OPCODE( 0x24, SLA_H,       "SLA H",         8, "----", "Z00C", sla_r< kH >() )
+GBEMU_CB_OPCODE( 0x25, SLA_L,       "SLA L",         8, "----", "Z00C", sla_r< kL >() )
+GBEMU_CB_OPCODE( 0x26, SLA_MHL,     "SLA (HL)",     16, "----", "Z00C", sla_r< kMHL >() )
+GBEMU_CB_OPCODE( 0x27, SLA_A,       "SLA A",         8, "----", "Z00C", sla_r< kA >() )
+GBEMU_CB_OPCODE( 0x28, SRA_B,       "SRA B",         8, "----", "Z00C", sra_r< kB >() )
+GBEMU_CB_OPCODE( 0x29, SRA_C,       "SRA C",         8, "----", "Z00C", sra_r< kC >() )
+GBEMU_CB_OPCODE( 0x2A, SRA_D,       "SRA D",         8, "----", "Z00C", sra_r< kD >() )
+GBEMU_CB_OPCODE( 0x2B, SRA_E,       "SRA E",         8, "----", "Z00C", sra_r< kE >() )
+GBEMU_CB_OPCODE( 0x2C, SRA_H,       "SRA H",         8, "----", "Z00C", sra_r< kH >() )
+GBEMU_CB_OPCODE( 0x2D, SRA_L,       "SRA L",         8, "----", "Z00C", sra_r< kL >() )
+GBEMU_CB_OPCODE( 0x2E, SRA_MHL,     "SRA (HL)",     16, "----", "Z00C", sra_r< kMHL >() )
+GBEMU_CB_OPCODE( 0x2F, SRA_A,       "SRA A",         8, "----", "Z00C", sra_r< kA >() )
+GBEMU_CB_OPCODE( 0x30, SWAP_B,      "SWAP B",        8, "----", "Z000", swap_r< kB >() )
+GBEMU_CB_OPCODE( 0x31, SWAP_C,      "SWAP C",        8, "----", "Z000", swap_r< kC >() )
+GBEMU_CB_OPCODE( 0x32, SWAP_D,      "SWAP D",        8, "----", "Z000", swap_r< kD >() )
+GBEMU_CB_OPCODE( 0x33, SWAP_E,      "SWAP E",        8, "----", "Z000", swap_r< kE >() )
+GBEMU_CB_OPCODE( 0x34, SWAP_H,      "SWAP H",        8, "----", "Z000", swap_r< kH >() )
+GBEMU_CB_OPCODE( 0x35, SWAP_L,      "SWAP L",        8, "----", "Z000", swap_r< kL >() )
+GBEMU_CB_OPCODE( 0x36, SWAP_MHL,    "SWAP (HL)",    16, "----", "Z000", swap_r< kMHL >() )
+GBEMU_CB_OPCODE( 0x37, SWAP_A,      "SWAP A",        8, "----", "Z000", swap_r< kA >() )
+GBEMU_CB_OPCODE( 0x38, SRL_B,       "SRL B",         8, "----", "Z00C", srl_r< kB >() )
+GBEMU_CB_OPCODE( 0x39, SRL_C,       "SRL C",         8, "----", "Z00C", srl_r< kC >() )
+GBEMU_CB_OPCODE( 0x3A, SRL_D,       "SRL D",         8, "----", "Z00C", srl_r< kD >() )
+GBEMU_CB_OPCODE( 0x3B, SRL_E,       "SRL E",         8, "----", "Z00C", srl_r< kE >() )
+GBEMU_CB_OPCODE( 0x3C, SRL_H,       "SRL H",         8, "----", "Z00C", srl_r< kH >() )
+GBEMU_CB_OPCODE( 0x3D, SRL_L,       "SRL L",         8, "----", "Z00C", srl_r< kL >() )
+GBEMU_CB_OPCODE( 0x3E, SRL_MHL,     "SRL (HL)",     16, "----", "Z00C", srl_r< kMHL >() )
+GBEMU_CB_OPCODE( 0x3F, SRL_A,       "SRL A",         8, "----", "Z00C", srl_r< kA >() )
+GBEMU_CB_OPCODE( 0x40, BIT_0_B,     "BIT 0,B",       8, "----", "Z01-", bit_b_r< 0, kB >() )
+GBEMU_CB_OPCODE( 0x41, BIT_0_C,     "BIT 0,C",       8, "----", "Z01-", bit_b_r< 0, kC >() )
+GBEMU_CB_OPCODE( 0x42, BIT_0_D,     "BIT 0,D",       8, "----", "Z01-", bit_b_r< 0, kD >() )
+GBEMU_CB_OPCODE( 0x43, BIT_0_E,     "BIT 0,E",       8, "----", "Z01-", bit_b_r< 0, kE >() )
+GBEMU_CB_OPCODE( 0x44, BIT_0_H,     "BIT 0,H",       8, "----", "Z01-", bit_b_r< 0, kH >() )
+GBEMU_CB_OPCODE( 0x45, BIT_0_L,     "BIT 0,L",       8, "----", "Z01-", bit_b_r< 0, kL >() )
+GBEMU_CB_OPCODE( 0x46, BIT_0_HL,    "BIT 0,(HL)",   16, "----", "Z01-", bit_b_r< 0, kMHL >() )
+GBEMU_CB_OPCODE( 0x47, BIT_0_A,     "BIT 0,A",       8, "----", "Z01-", bit_b_r< 0, kA >() )
+GBEMU_CB_OPCODE( 0x48, BIT_1_B,     "BIT 1,B",       8, "----", "Z01-", bit_b_r< 1, kB >() )
+GBEMU_CB_OPCODE( 0x49, BIT_1_C,     "BIT 1,C",       8, "----", "Z01-", bit_b_r< 1, kC >() )
+GBEMU_CB_OPCODE( 0x4A, BIT_1_D,     "BIT 1,D",       8, "----", "Z01-", bit_b_r< 1, kD >() )
+GBEMU_CB_OPCODE( 0x4B, BIT_1_E,     "BIT 1,E",       8, "----", "Z01-", bit_b_r< 1, kE >() )
+GBEMU_CB_OPCODE( 0x4C, BIT_1_H,     "BIT 1,H",       8, "----", "Z01-", bit_b_r< 1, kH >() )
+GBEMU_CB_OPCODE( 0x4D, BIT_1_L,     "BIT 1,L",       8, "----", "Z01-", bit_b_r< 1, kL >() )
+GBEMU_CB_OPCODE( 0x4E, BIT_1_HL,    "BIT 1,(HL)",   16, "----", "Z01-", bit_b_r< 1, kMHL >() )
+GBEMU_CB_OPCODE( 0x4F, BIT_1_A,     "BIT 1,A",       8, "----", "Z01-", bit_b_r< 1, kA >() )
+GBEMU_CB_OPCODE( 0x50, BIT_2_B,     "BIT 2,B",       8, "----", "Z01-", bit_b_r< 2, kB >() )
+GBEMU_CB_OPCODE( 0x51, BIT_2_C,     "BIT 2,C",       8, "----", "Z01-", bit_b_r< 2, kC >() )
+GBEMU_CB_OPCODE( 0x52, BIT_2_D,     "BIT 2,D",       8, "----", "Z01-", bit_b_r< 2, kD >() )
+GBEMU_CB_OPCODE( 0x53, BIT_2_E,     "BIT 2,E",       8, "----", "Z01-", bit_b_r< 2, kE >() )
+GBEMU_CB_OPCODE( 0x54, BIT_2_H,     "BIT 2,H",       8, "----", "Z01-", bit_b_r< 2, kH >() )
+GBEMU_CB_OPCODE( 0x55, BIT_2_L,     "BIT 2,L",       8, "----", "Z01-", bit_b_r< 2, kL >() )
+GBEMU_CB_OPCODE( 0x56, BIT_2_HL,    "BIT 2,(HL)",   16, "----", "Z01-", bit_b_r< 2, kMHL >() )
+GBEMU_CB_OPCODE( 0x57, BIT_2_A,     "BIT 2,A",       8, "----", "Z01-", bit_b_r< 2, kA >() )
+GBEMU_CB_OPCODE( 0x58, BIT_3_B,     "BIT 3,B",       8, "----", "Z01-", bit_b_r< 3, kB >() )
+GBEMU_CB_OPCODE( 0x59, BIT_3_C,     "BIT 3,C",       8, "----", "Z01-", bit_b_r< 3, kC >() )
+GBEMU_CB_OPCODE( 0x5A, BIT_3_D,     "BIT 3,D",       8, "----", "Z01-", bit_b_r< 3, kD >() )
+GBEMU_CB_OPCODE( 0x5B, BIT_3_E,     "BIT 3,E",       8, "----", "Z01-", bit_b_r< 3, kE >() )
+GBEMU_CB_OPCODE( 0x5C, BIT_3_H,     "BIT 3,H",       8, "----", "Z01-", bit_b_r< 3, kH >() )
+GBEMU_CB_OPCODE( 0x5D, BIT_3_L,     "BIT 3,L",       8, "----", "Z01-", bit_b_r< 3, kL >() )
+GBEMU_CB_OPCODE( 0x5E, BIT_3_HL,    "BIT 3,(HL)",   16, "----", "Z01-", bit_b_r< 3, kMHL >() )
+GBEMU_CB_OPCODE( 0x5F, BIT_3_A,     "BIT 3,A",       8, "----", "Z01-", bit_b_r< 3, kA >() )
+GBEMU_CB_OPCODE( 0x60, BIT_4_B,     "BIT 4,B",       8, "----", "Z01-", bit_b_r< 4, kB >() )
+GBEMU_CB_OPCODE( 0x61, BIT_4_C,     "BIT 4,C",       8, "----", "Z01-", bit_b_r< 4, kC >() )
+GBEMU_CB_OPCODE( 0x62, BIT_4_D,     "BIT 4,D",       8, "----", "Z01-", bit_b_r< 4, kD >() )
+GBEMU_CB_OPCODE( 0x63, BIT_4_E,     "BIT 4,E",       8, "----", "Z01-", bit_b_r< 4, kE >() )
+GBEMU_CB_OPCODE( 0x64, BIT_4_H,     "BIT 4,H",       8, "----", "Z01-", bit_b_r< 4, kH >() )
+GBEMU_CB_OPCODE( 0x65, BIT_4_L,     "BIT 4,L",       8, "----", "Z01-", bit_b_r< 4, kL >() )
+GBEMU_CB_OPCODE( 0x66, BIT_4_HL,    "BIT 4,(HL)",   16, "----", "Z01-", bit_b_r< 4, kMHL >() )
+GBEMU_CB_OPCODE( 0x67, BIT_4_A,     "BIT 4,A",       8, "----", "Z01-", bit_b_r< 4, kA >() )
+GBEMU_CB_OPCODE( 0x68, BIT_5_B,     "BIT 5,B",       8, "----", "Z01-", bit_b_r< 5, kB >() )
+GBEMU_CB_OPCODE( 0x69, BIT_5_C,     "BIT 5,C",       8, "----", "Z01-", bit_b_r< 5, kC >() )
+GBEMU_CB_OPCODE( 0x6A, BIT_5_D,     "BIT 5,D",       8, "----", "Z01-", bit_b_r< 5, kD >() )
+GBEMU_CB_OPCODE( 0x6B, BIT_5_E,     "BIT 5,E",       8, "----", "Z01-", bit_b_r< 5, kE >() )
+GBEMU_CB_OPCODE( 0x6C, BIT_5_H,     "BIT 5,H",       8, "----", "Z01-", bit_b_r< 5, kH >() )
+GBEMU_CB_OPCODE( 0x6D, BIT_5_L,     "BIT 5,L",       8, "----", "Z01-", bit_b_r< 5, kL >() )
+GBEMU_CB_OPCODE( 0x6E, BIT_5_HL,    "BIT 5,(HL)",   16, "----", "Z01-", bit_b_r< 5, kMHL >() )
+GBEMU_CB_OPCODE( 0x6F, BIT_5_A,     "BIT 5,A",       8, "----", "Z01-", bit_b_r< 5, kA >() )
+GBEMU_CB_OPCODE( 0x70, BIT_6_B,     "BIT 6,B",       8, "----", "Z01-", bit_b_r< 6, kB >() )
+GBEMU_CB_OPCODE( 0x71, BIT_6_C,     "BIT 6,C",       8, "----", "Z01-", bit_b_r< 6, kC >() )
+GBEMU_CB_OPCODE( 0x72, BIT_6_D,     "BIT 6,D",       8, "----", "Z01-", bit_b_r< 6, kD >() )
+GBEMU_CB_OPCODE( 0x73, BIT_6_E,     "BIT 6,E",       8, "----", "Z01-", bit_b_r< 6, kE >() )
+GBEMU_CB_OPCODE( 0x74, BIT_6_H,     "BIT 6,H",       8, "----", "Z01-", bit_b_r< 6, kH >() )
+GBEMU_CB_OPCODE( 0x75, BIT_6_L,     "BIT 6,L",       8, "----", "Z01-", bit_b_r< 6, kL >() )
+GBEMU_CB_OPCODE( 0x76, BIT_6_HL,    "BIT 6,(HL)",   16, "----", "Z01-", bit_b_r< 6, kMHL >() )
+GBEMU_CB_OPCODE( 0x77, BIT_6_A,     "BIT 6,A",       8, "----", "Z01-", bit_b_r< 6, kA >() )
+GBEMU_CB_OPCODE( 0x78, BIT_7_B,     "BIT 7,B",       8, "----", "Z01-", bit_b_r< 7, kB >() )
+GBEMU_CB_OPCODE( 0x79, BIT_7_C,     "BIT 7,C",       8, "----", "Z01-", bit_b_r< 7, kC >() )
+GBEMU_CB_OPCODE( 0x7A, BIT_7_D,     "BIT 7,D",       8, "----", "Z01-", bit_b_r< 7, kD >() )
+GBEMU_CB_OPCODE( 0x7B, BIT_7_E,     "BIT 7,E",       8, "----", "Z01-", bit_b_r< 7, kE >() )
+GBEMU_CB_OPCODE( 0x7C, BIT_7_H,     "BIT 7,H",       8, "----", "Z01-", bit_b_r< 7, kH >() )
+GBEMU_CB_OPCODE( 0x7D, BIT_7_L,     "BIT 7,L",       8, "----", "Z01-", bit_b_r< 7, kL >() )
+GBEMU_CB_OPCODE( 0x7E, BIT_7_HL,    "BIT 7,(HL)",   16, "----", "Z01-", bit_b_r< 7, kMHL >() )
+GBEMU_CB_OPCODE( 0x7F, BIT_7_A,     "BIT 7,A",       8, "----", "Z01-", bit_b_r< 7, kA >() )
+GBEMU_CB_OPCODE( 0x80, RES_0_B,     "RES 0,B",       8, "----", "----", res_b_r< 0, kB >() )
+GBEMU_CB_OPCODE( 0x81, RES_0_C,     "RES 0,C",       8, "----", "----", res_b_r< 0, kC >() )
+GBEMU_CB_OPCODE( 0x82, RES_0_D,     "RES 0,D",       8, "----", "----", res_b_r< 0, kD >() )
+GBEMU_CB_OPCODE( 0x83, RES_0_E,     "RES 0,E",       8, "----", "----", res_b_r< 0, kE >() )
+GBEMU_CB_OPCODE( 0x84, RES_0_H,     "RES 0,H",       8, "----", "----", res_b_r< 0, kH >() )
+GBEMU_CB_OPCODE( 0x85, RES_0_L,     "RES 0,L",       8, "----", "----", res_b_r< 0, kL >() )
+GBEMU_CB_OPCODE( 0x86, RES_0_HL,    "RES 0,(HL)",   16, "----", "----", res_b_r< 0, kMHL >() )
+GBEMU_CB_OPCODE( 0x87, RES_0_A,     "RES 0,A",       8, "----", "----", res_b_r< 0, kA >() )
+GBEMU_CB_OPCODE( 0x88, RES_1_B,     "RES 1,B",       8, "----", "----", res_b_r< 1, kB >() )
+GBEMU_CB_OPCODE( 0x89, RES_1_C,     "RES 1,C",       8, "----", "----", res_b_r< 1, kC >() )
+GBEMU_CB_OPCODE( 0x8A, RES_1_D,     "RES 1,D",       8, "----", "----", res_b_r< 1, kD >() )
+GBEMU_CB_OPCODE( 0x8B, RES_1_E,     "RES 1,E",       8, "----", "----", res_b_r< 1, kE >() )
+GBEMU_CB_OPCODE( 0x8C, RES_1_H,     "RES 1,H",       8, "----", "----", res_b_r< 1, kH >() )
+GBEMU_CB_OPCODE( 0x8D, RES_1_L,     "RES 1,L",       8, "----", "----", res_b_r< 1, kL >() )
+GBEMU_CB_OPCODE( 0x8E, RES_1_HL,    "RES 1,(HL)",   16, "----", "----", res_b_r< 1, kMHL >() )
+GBEMU_CB_OPCODE( 0x8F, RES_1_A,     "RES 1,A",       8, "----", "----", res_b_r< 1, kA >() )
+GBEMU_CB_OPCODE( 0x90, RES_2_B,     "RES 2,B",       8, "----", "----", res_b_r< 2, kB >() )
+GBEMU_CB_OPCODE( 0x91, RES_2_C,     "RES 2,C",       8, "----", "----", res_b_r< 2, kC >() )
+GBEMU_CB_OPCODE( 0x92, RES_2_D,     "RES 2,D",       8, "----", "----", res_b_r< 2, kD >() )
+GBEMU_CB_OPCODE( 0x93, RES_2_E,     "RES 2,E",       8, "----", "----", res_b_r< 2, kE >() )
+GBEMU_CB_OPCODE( 0x94, RES_2_H,     "RES 2,H",       8, "----", "----", res_b_r< 2, kH >() )
+GBEMU_CB_OPCODE( 0x95, RES_2_L,     "RES 2,L",       8, "----", "----", res_b_r< 2, kL >() )
+GBEMU_CB_OPCODE( 0x96, RES_2_HL,    "RES 2,(HL)",   16, "----", "----", res_b_r< 2, kMHL >() )
+GBEMU_CB_OPCODE( 0x97, RES_2_A,     "RES 2,A",       8, "----", "----", res_b_r< 2, kA >() )
+GBEMU_CB_OPCODE( 0x98, RES_3_B,     "RES 3,B",       8, "----", "----", res_b_r< 3, kB >() )
+GBEMU_CB_OPCODE( 0x99, RES_3_C,     "RES 3,C",       8, "----", "----", res_b_r< 3, kC >() )
+GBEMU_CB_OPCODE( 0x9A, RES_3_D,     "RES 3,D",       8, "----", "----", res_b_r< 3, kD >() )
+GBEMU_CB_OPCODE( 0x9B, RES_3_E,     "RES 3,E",       8, "----", "----", res_b_r< 3, kE >() )
+GBEMU_CB_OPCODE( 0x9C, RES_3_H,     "RES 3,H",       8, "----", "----", res_b_r< 3, kH >() )
+GBEMU_CB_OPCODE( 0x9D, RES_3_L,     "RES 3,L",       8, "----", "----", res_b_r< 3, kL >() )
+GBEMU_CB_OPCODE( 0x9E, RES_3_HL,    "RES 3,(HL)",   16, "----", "----", res_b_r< 3, kMHL >() )
+GBEMU_CB_OPCODE( 0x9F, RES_3_A,     "RES 3,A",       8, "----", "----", res_b_r< 3, kA >() )
+GBEMU_CB_OPCODE( 0xA0, RES_4_B,     "RES 4,B",       8, "----", "----", res_b_r< 4, kB >() )
+GBEMU_CB_OPCODE( 0xA1, RES_4_C,     "RES 4,C",       8, "----", "----", res_b_r< 4, kC >() )
+GBEMU_CB_OPCODE( 0xA2, RES_4_D,     "RES 4,D",       8, "----", "----", res_b_r< 4, kD >() )
+GBEMU_CB_OPCODE( 0xA3, RES_4_E,     "RES 4,E",       8, "----", "----", res_b_r< 4, kE >() )
+GBEMU_CB_OPCODE( 0xA4, RES_4_H,     "RES 4,H",       8, "----", "----", res_b_r< 4, kH >() )
+GBEMU_CB_OPCODE( 0xA5, RES_4_L,     "RES 4,L",       8, "----", "----", res_b_r< 4, kL >() )
+GBEMU_CB_OPCODE( 0xA6, RES_4_HL,    "RES 4,(HL)",   16, "----", "----", res_b_r< 4, kMHL >() )
+GBEMU_CB_OPCODE( 0xA7, RES_4_A,     "RES 4,A",       8, "----", "----", res_b_r< 4, kA >() )
+GBEMU_CB_OPCODE( 0xA8, RES_5_B,     "RES 5,B",       8, "----", "----", res_b_r< 5, kB >() )
+GBEMU_CB_OPCODE( 0xA9, RES_5_C,     "RES 5,C",       8, "----", "----", res_b_r< 5, kC >() )
+GBEMU_CB_OPCODE( 0xAA, RES_5_D,     "RES 5,D",       8, "----", "----", res_b_r< 5, kD >() )
+GBEMU_CB_OPCODE( 0xAB, RES_5_E,     "RES 5,E",       8, "----", "----", res_b_r< 5, kE >() )
+GBEMU_CB_OPCODE( 0xAC, RES_5_H,     "RES 5,H",       8, "----", "----", res_b_r< 5, kH >() )
+GBEMU_CB_OPCODE( 0xAD, RES_5_L,     "RES 5,L",       8, "----", "----", res_b_r< 5, kL >() )
+GBEMU_CB_OPCODE( 0xAE, RES_5_HL,    "RES 5,(HL)",   16, "----", "----", res_b_r< 5, kMHL >() )
+GBEMU_CB_OPCODE( 0xAF, RES_5_A,     "RES 5,A",       8, "----", "----", res_b_r< 5, kA >() )
+GBEMU_CB_OPCODE( 0xB0, RES_6_B,     "RES 6,B",       8, "----", "----", res_b_r< 6, kB >() )
+GBEMU_CB_OPCODE( 0xB1, RES_6_C,     "RES 6,C",       8, "----", "----", res_b_r< 6, kC >() )
+GBEMU_CB_OPCODE( 0xB2, RES_6_D,     "RES 6,D",       8, "----", "----", res_b_r< 6, kD >() )
+GBEMU_CB_OPCODE( 0xB3, RES_6_E,     "RES 6,E",       8, "----", "----", res_b_r< 6, kE >() )
+GBEMU_CB_OPCODE( 0xB4, RES_6_H,     "RES 6,H",       8, "----", "----", res_b_r< 6, kH >() )
+GBEMU_CB_OPCODE( 0xB5, RES_6_L,     "RES 6,L",       8, "----", "----", res_b_r< 6, kL >() )
+GBEMU_CB_OPCODE( 0xB6, RES_6_HL,    "RES 6,(HL)",   16, "----", "----", res_b_r< 6, kMHL >() )
+GBEMU_CB_OPCODE( 0xB7, RES_6_A,     "RES 6,A",       8, "----", "----", res_b_r< 6, kA >() )
+GBEMU_CB_OPCODE( 0xB8, RES_7_B,     "RES 7,B",       8, "----", "----", res_b_r< 7, kB >() )
+GBEMU_CB_OPCODE( 0xB9, RES_7_C,     "RES 7,C",       8, "----", "----", res_b_r< 7, kC >() )
+GBEMU_CB_OPCODE( 0xBA, RES_7_D,     "RES 7,D",       8, "----", "----", res_b_r< 7, kD >() )
+GBEMU_CB_OPCODE( 0xBB, RES_7_E,     "RES 7,E",       8, "----", "----", res_b_r< 7, kE >() )
+GBEMU_CB_OPCODE( 0xBC, RES_7_H,     "RES 7,H",       8, "----", "----", res_b_r< 7, kH >() )
+GBEMU_CB_OPCODE( 0xBD, RES_7_L,     "RES 7,L",       8, "----", "----", res_b_r< 7, kL >() )
+GBEMU_CB_OPCODE( 0xBE, RES_7_HL,    "RES 7,(HL)",   16, "----", "----", res_b_r< 7, kMHL >() )
+GBEMU_CB_OPCODE( 0xBF, RES_7_A,     "RES 7,A",       8, "----", "----", res_b_r< 7, kA >() )
+GBEMU_CB_OPCODE( 0xC0, SET_0_B,     "SET 0,B",       8, "----", "----", set_b_r< 0, kB >() )
+GBEMU_CB_OPCODE( 0xC1, SET_0_C,     "SET 0,C",       8, "----", "----", set_b_r< 0, kC >() )
+GBEMU_CB_OPCODE( 0xC2, SET_0_D,     "SET 0,D",       8, "----", "----", set_b_r< 0, kD >() )
+GBEMU_CB_OPCODE( 0xC3, SET_0_E,     "SET 0,E",       8, "----", "----", set_b_r< 0, kE >() )
+GBEMU_CB_OPCODE( 0xC4, SET_0_H,     "SET 0,H",       8, "----", "----", set_b_r< 0, kH >() )
+GBEMU_CB_OPCODE( 0xC5, SET_0_L,     "SET 0,L",       8, "----", "----", set_b_r< 0, kL >() )
+GBEMU_CB_OPCODE( 0xC6, SET_0_HL,    "SET 0,(HL)",   16, "----", "----", set_b_r< 0, kMHL >() )
+GBEMU_CB_OPCODE( 0xC7, SET_0_A,     "SET 0,A",       8, "----", "----", set_b_r< 0, kA >() )
+GBEMU_CB_OPCODE( 0xC8, SET_1_B,     "SET 1,B",       8, "----", "----", set_b_r< 1, kB >() )
+GBEMU_CB_OPCODE( 0xC9, SET_1_C,     "SET 1,C",       8, "----", "----", set_b_r< 1, kC >() )
+GBEMU_CB_OPCODE( 0xCA, SET_1_D,     "SET 1,D",       8, "----", "----", set_b_r< 1, kD >() )
+GBEMU_CB_OPCODE( 0xCB, SET_1_E,     "SET 1,E",       8, "----", "----", set_b_r< 1, kE >() )
+GBEMU_CB_OPCODE( 0xCC, SET_1_H,     "SET 1,H",       8, "----", "----", set_b_r< 1, kH >() )
+GBEMU_CB_OPCODE( 0xCD, SET_1_L,     "SET 1,L",       8, "----", "----", set_b_r< 1, kL >() )
+GBEMU_CB_OPCODE( 0xCE, SET_1_HL,    "SET 1,(HL)",   16, "----", "----", set_b_r< 1, kMHL >() )
+GBEMU_CB_OPCODE( 0xCF, SET_1_A,     "SET 1,A",       8, "----", "----", set_b_r< 1, kA >() )
+GBEMU_CB_OPCODE( 0xD0, SET_2_B,     "SET 2,B",       8, "----", "----", set_b_r< 2, kB >() )
+GBEMU_CB_OPCODE( 0xD1, SET_2_C,     "SET 2,C",       8, "----", "----", set_b_r< 2, kC >() )
+GBEMU_CB_OPCODE( 0xD2, SET_2_D,     "SET 2,D",       8, "----", "----", set_b_r< 2, kD >() )
+GBEMU_CB_OPCODE( 0xD3, SET_2_E,     "SET 2,E",       8, "----", "----", set_b_r< 2, kE >() )
+GBEMU_CB_OPCODE( 0xD4, SET_2_H,     "SET 2,H",       8, "----", "----", set_b_r< 2, kH >() )
+GBEMU_CB_OPCODE( 0xD5, SET_2_L,     "SET 2,L",       8, "----", "----", set_b_r< 2, kL >() )
+GBEMU_CB_OPCODE( 0xD6, SET_2_HL,    "SET 2,(HL)",   16, "----", "----", set_b_r< 2, kMHL >() )
+GBEMU_CB_OPCODE( 0xD7, SET_2_A,     "SET 2,A",       8, "----", "----", set_b_r< 2, kA >() )
+GBEMU_CB_OPCODE( 0xD8, SET_3_B,     "SET 3,B",       8, "----", "----", set_b_r< 3, kB >() )
+GBEMU_CB_OPCODE( 0xD9, SET_3_C,     "SET 3,C",       8, "----", "----", set_b_r< 3, kC >() )
+GBEMU_CB_OPCODE( 0xDA, SET_3_D,     "SET 3,D",       8, "----", "----", set_b_r< 3, kD >() )
+GBEMU_CB_OPCODE( 0xDB, SET_3_E,     "SET 3,E",       8, "----", "----", set_b_r< 3, kE >() )
+GBEMU_CB_OPCODE( 0xDC, SET_3_H,     "SET 3,H",       8, "----", "----", set_b_r< 3, kH >() )
+GBEMU_CB_OPCODE( 0xDD, SET_3_L,     "SET 3,L",       8, "----", "----", set_b_r< 3, kL >() )
+GBEMU_CB_OPCODE( 0xDE, SET_3_HL,    "SET 3,(HL)",   16, "----", "----", set_b_r< 3, kMHL >() )
+GBEMU_CB_OPCODE( 0xDF, SET_3_A,     "SET 3,A",       8, "----", "----", set_b_r< 3, kA >() )
+GBEMU_CB_OPCODE( 0xE0, SET_4_B,     "SET 4,B",       8, "----", "----", set_b_r< 4, kB >() )
+GBEMU_CB_OPCODE( 0xE1, SET_4_C,     "SET 4,C",       8, "----", "----", set_b_r< 4, kC >() )
+GBEMU_CB_OPCODE( 0xE2, SET_4_D,     "SET 4,D",       8, "----", "----", set_b_r< 4, kD >() )
+GBEMU_CB_OPCODE( 0xE3, SET_4_E,     "SET 4,E",       8, "----", "----", set_b_r< 4, kE >() )
+GBEMU_CB_OPCODE( 0xE4, SET_4_H,     "SET 4,H",       8, "----", "----", set_b_r< 4, kH >() )
+GBEMU_CB_OPCODE( 0xE5, SET_4_L,     "SET 4,L",       8, "----", "----", set_b_r< 4, kL >() )
+GBEMU_CB_OPCODE( 0xE6, SET_4_HL,    "SET 4,(HL)",   16, "----", "----", set_b_r< 4, kMHL >() )
+GBEMU_CB_OPCODE( 0xE7, SET_4_A,     "SET 4,A",       8, "----", "----", set_b_r< 4, kA >() )
+GBEMU_CB_OPCODE( 0xE8, SET_5_B,     "SET 5,B",       8, "----", "----", set_b_r< 5, kB >() )
+GBEMU_CB_OPCODE( 0xE9, SET_5_C,     "SET 5,C",       8, "----", "----", set_b_r< 5, kC >() )
+GBEMU_CB_OPCODE( 0xEA, SET_5_D,     "SET 5,D",       8, "----", "----", set_b_r< 5, kD >() )
+GBEMU_CB_OPCODE( 0xEB, SET_5_E,     "SET 5,E",       8, "----", "----", set_b_r< 5, kE >() )
+GBEMU_CB_OPCODE( 0xEC, SET_5_H,     "SET 5,H",       8, "----", "----", set_b_r< 5, kH >() )
+GBEMU_CB_OPCODE( 0xED, SET_5_L,     "SET 5,L",       8, "----", "----", set_b_r< 5, kL >() )
+GBEMU_CB_OPCODE( 0xEE, SET_5_HL,    "SET 5,(HL)",   16, "----", "----", set_b_r< 5, kMHL >() )
+GBEMU_CB_OPCODE( 0xEF, SET_5_A,     "SET 5,A",       8, "----", "----", set_b_r< 5, kA >() )
+GBEMU_CB_OPCODE( 0xF0, SET_6_B,     "SET 6,B",       8, "----", "----", set_b_r< 6, kB >() )
+GBEMU_CB_OPCODE( 0xF1, SET_6_C,     "SET 6,C",       8, "----", "----", set_b_r< 6, kC >() )
+GBEMU_CB_OPCODE( 0xF2, SET_6_D,     "SET 6,D",       8, "----", "----", set_b_r< 6, kD >() )
+GBEMU_CB_OPCODE( 0xF3, SET_6_E,     "SET 6,E",       8, "----", "----", set_b_r< 6, kE >() )
+GBEMU_CB_OPCODE( 0xF4, SET_6_H,     "SET 6,H",       8, "----", "----", set_b_r< 6, kH >() )
+GBEMU_CB_OPCODE( 0xF5, SET_6_L,     "SET 6,L",       8, "----", "----", set_b_r< 6, kL >() )
+GBEMU_CB_OPCODE( 0xF6, SET_6_HL,    "SET 6,(HL)",   16, "----", "----", set_b_r< 6, kMHL >() )
+GBEMU_CB_OPCODE( 0xF7, SET_6_A,     "SET 6,A",       8, "----", "----", set_b_r< 6, kA >() )
+GBEMU_CB_OPCODE( 0xF8, SET_7_B,     "SET 7,B",       8, "----", "----", set_b_r< 7, kB >() )
+GBEMU_CB_OPCODE( 0xF9, SET_7_C,     "SET 7,C",       8, "----", "----", set_b_r< 7, kC >() )
+GBEMU_CB_OPCODE( 0xFA, SET_7_D,     "SET 7,D",       8, "----", "----", set_b_r< 7, kD >() )
+GBEMU_CB_OPCODE( 0xFB, SET_7_E,     "SET 7,E",       8, "----", "----", set_b_r< 7, kE >() )
+GBEMU_CB_OPCODE( 0xFC, SET_7_H,     "SET 7,H",       8, "----", "----", set_b_r< 7, kH >() )
+GBEMU_CB_OPCODE( 0xFD, SET_7_L,     "SET 7,L",       8, "----", "----", set_b_r< 7, kL >() )
+GBEMU_CB_OPCODE( 0xFE, SET_7_HL,    "SET 7,(HL)",   16, "----", "----", set_b_r< 7, kMHL >() )
+GBEMU_CB_OPCODE( 0xFF, SET_7_A,     "SET 7,A",       8, "----", "----", set_b_r< 7, kA >() )
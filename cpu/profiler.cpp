@@ -0,0 +1,152 @@
+#include <cpu/profiler.h>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+
+namespace {
+
+    using namespace gbemu;
+
+    double getShare( const unsigned long long cycles, const unsigned long long totalCycles )
+    {
+        return totalCycles == 0 ? 0.0 : double( cycles ) / double( totalCycles );
+    }
+
+    template< typename Entry >
+    bool hasMoreCycles( const Entry& left, const Entry& right )
+    {
+        return left.cycles > right.cycles || ( left.cycles == right.cycles && left.key < right.key );
+    }
+
+    template< typename Entry >
+    void keepTop( std::vector< Entry >& entries, const size_t topCount )
+    {
+        const size_t count = std::min( topCount, entries.size() );
+        std::partial_sort( entries.begin(), entries.begin() + count, entries.end(), hasMoreCycles< Entry > );
+        entries.resize( count );
+    }
+}
+
+namespace gbemu {
+
+    const char* getOpcodeName( const unsigned int opcode )
+    {
+        return getOpcodeInfo( static_cast< Opcode >( opcode ) ).name;
+    }
+
+    Profiler::Profiler()
+    {
+        reset();
+    }
+
+    void Profiler::reset()
+    {
+        _addresses.clear();
+        memset( _opcodes, 0, sizeof( _opcodes ) );
+        memset( _cbOpcodes, 0, sizeof( _cbOpcodes ) );
+        _totalCycles = 0;
+    }
+
+    unsigned long long Profiler::getTotalCycles() const
+    {
+        return _totalCycles;
+    }
+
+    std::vector< Profiler::Entry > Profiler::getTopAddresses( const size_t topCount ) const
+    {
+        std::vector< Entry > entries;
+        entries.reserve( _addresses.size() );
+        for ( std::unordered_map< unsigned int, Counter >::const_iterator it = _addresses.begin(); it != _addresses.end(); ++it ) {
+            const Entry entry = { it->first, it->second.executions, it->second.cycles };
+            entries.push_back( entry );
+        }
+        keepTop( entries, topCount );
+        return entries;
+    }
+
+    std::vector< Profiler::Entry > Profiler::getTopOpcodes( const size_t topCount ) const
+    {
+        std::vector< Entry > entries;
+        for ( unsigned int i = 0; i < 256; ++i ) {
+            if ( _opcodes[ i ].executions != 0 ) {
+                const Entry entry = { i, _opcodes[ i ].executions, _opcodes[ i ].cycles };
+                entries.push_back( entry );
+            }
+            if ( _cbOpcodes[ i ].executions != 0 ) {
+                const Entry entry = { 0xCB00 | i, _cbOpcodes[ i ].executions, _cbOpcodes[ i ].cycles };
+                entries.push_back( entry );
+            }
+        }
+        keepTop( entries, topCount );
+        return entries;
+    }
+
+    void Profiler::writeReport( std::ostream& os, const size_t topCount ) const
+    {
+        const std::ios::fmtflags flags( os.flags() );
+        const std::streamsize precision( os.precision() );
+        os << "Total cycles: " << _totalCycles << std::endl;
+
+        os << std::endl << "Top addresses" << std::endl;
+        os << std::setw( 9 ) << "bank:pc" << std::setw( 14 ) << "executions" << std::setw( 14 ) << "cycles" << std::setw( 9 ) << "share" << std::endl;
+        const std::vector< Entry > addresses( getTopAddresses( topCount ) );
+        for ( size_t i = 0; i < addresses.size(); ++i ) {
+            const Entry& entry( addresses[ i ] );
+            os << std::hex << std::setfill( '0' )
+               << "  " << std::setw( 2 ) << ( entry.key >> 16 ) << ':' << std::setw( 4 ) << ( entry.key & 0xFFFF )
+               << std::dec << std::setfill( ' ' )
+               << std::setw( 14 ) << entry.executions << std::setw( 14 ) << entry.cycles
+               << std::setw( 8 ) << std::fixed << std::setprecision( 2 ) << getShare( entry.cycles, _totalCycles ) * 100 << '%' << std::endl;
+        }
+
+        os << std::endl << "Top opcodes" << std::endl;
+        os << std::setw( 14 ) << "opcode" << std::setw( 14 ) << "executions" << std::setw( 14 ) << "cycles" << std::setw( 9 ) << "share" << std::endl;
+        const std::vector< Entry > opcodes( getTopOpcodes( topCount ) );
+        for ( size_t i = 0; i < opcodes.size(); ++i ) {
+            const Entry& entry( opcodes[ i ] );
+            os << std::setw( 14 ) << getOpcodeName( entry.key )
+               << std::setw( 14 ) << entry.executions << std::setw( 14 ) << entry.cycles
+               << std::setw( 8 ) << std::fixed << std::setprecision( 2 ) << getShare( entry.cycles, _totalCycles ) * 100 << '%' << std::endl;
+        }
+        os.flags( flags );
+        os.precision( precision );
+    }
+
+    void Profiler::writeJSON( std::ostream& os, const size_t topCount ) const
+    {
+        const std::ios::fmtflags flags( os.flags( std::ios::dec ) );
+        const std::streamsize precision( os.precision( 6 ) );
+        os << "{" << std::endl;
+        os << "  \"totalCycles\": " << _totalCycles << "," << std::endl;
+
+        os << "  \"addresses\": [";
+        const std::vector< Entry > addresses( getTopAddresses( topCount ) );
+        for ( size_t i = 0; i < addresses.size(); ++i ) {
+            const Entry& entry( addresses[ i ] );
+            os << ( i == 0 ? "" : "," ) << std::endl
+               << "    { \"bank\": " << ( entry.key >> 16 )
+               << ", \"pc\": " << ( entry.key & 0xFFFF )
+               << ", \"executions\": " << entry.executions
+               << ", \"cycles\": " << entry.cycles
+               << ", \"share\": " << getShare( entry.cycles, _totalCycles ) << " }";
+        }
+        os << std::endl << "  ]," << std::endl;
+
+        os << "  \"opcodes\": [";
+        const std::vector< Entry > opcodes( getTopOpcodes( topCount ) );
+        for ( size_t i = 0; i < opcodes.size(); ++i ) {
+            const Entry& entry( opcodes[ i ] );
+            os << ( i == 0 ? "" : "," ) << std::endl
+               << "    { \"opcode\": " << entry.key
+               << ", \"name\": \"" << getOpcodeName( entry.key ) << "\""
+               << ", \"executions\": " << entry.executions
+               << ", \"cycles\": " << entry.cycles
+               << ", \"share\": " << getShare( entry.cycles, _totalCycles ) << " }";
+        }
+        os << std::endl << "  ]" << std::endl;
+        os << "}" << std::endl;
+        os.flags( flags );
+        os.precision( precision );
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cpu/opcode.h>
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+namespace gbemu {
+
+    // Mnemonic of an opcode, as named in opcodeTable.inl.
+    const char* getOpcodeName( unsigned int opcode );
+
+    // Counts the instructions executed by the guest and the cycles they took,
+    // per ROM bank and address and per opcode.
+    class Profiler
+    {
+    public:
+        // Counter of an address ( bank << 16 | pc ) or an opcode.
+        struct Entry
+        {
+            unsigned int       key;
+            unsigned long long executions;
+            unsigned long long cycles;
+        };
+
+        Profiler();
+
+        JFX_INLINE void record( int bank, unsigned short pc, Opcode opcode, int nbCycles );
+        void reset();
+        unsigned long long getTotalCycles() const;
+
+        // Lists the topCount addresses and opcodes that took the most cycles.
+        void writeReport( std::ostream& os, size_t topCount ) const;
+        void writeJSON( std::ostream& os, size_t topCount ) const;
+
+        std::vector< Entry > getTopAddresses( size_t topCount ) const;
+        std::vector< Entry > getTopOpcodes( size_t topCount ) const;
+
+    private:
+        struct Counter
+        {
+            unsigned long long executions;
+            unsigned long long cycles;
+        };
+
+        std::unordered_map< unsigned int, Counter > _addresses;
+        Counter _opcodes[ 256 ];
+        Counter _cbOpcodes[ 256 ];
+        unsigned long long _totalCycles;
+    };
+
+    void Profiler::record(
+        const int            bank,
+        const unsigned short pc,
+        const Opcode         opcode,
+        const int            nbCycles
+    )
+    {
+        Counter& address( _addresses[ static_cast< unsigned int >( bank ) << 16 | pc ] );
+        ++address.executions;
+        address.cycles += nbCycles;
+
+        Counter& op( isCBOpcode( opcode ) ? _cbOpcodes[ opcode & 0xFF ] : _opcodes[ opcode & 0xFF ] );
+        ++op.executions;
+        op.cycles += nbCycles;
+
+        _totalCycles += nbCycles;
+    }
+}
@@ -1,9 +1,17 @@
 #include <cpu/timers.h>
 #include <memory/memory.h>
+#include <algorithm>
 
 
 namespace gbemu {
 
+    const int Timers::kCyclesPerTimerCounter[ 4 ] = {
+        kCPUSpeed / 4096,
+        kCPUSpeed / 262144,
+        kCPUSpeed / 65536,
+        kCPUSpeed / 16384
+    };
+
     Timers::Timers( Memory& memory ) :
         _cyclesToIncTimerCounter( 0 ),
         _cyclesToIncDivider( 0 ),
@@ -60,30 +68,40 @@ namespace gbemu {
     void Timers::emulate(int nbCycles)
     {
         // timer register is increment 16384 times per second, once every 256 cycles. When doing so, increment div
+        // nbCycles can span several increments when the CPU is halted.
         _cyclesToIncDivider -= nbCycles;
-        if (_cyclesToIncDivider < 0) {
+        while (_cyclesToIncDivider < 0) {
             _cyclesToIncDivider += kClockPerDividerCycle;
             ++_div;
         }
 
         // If Timer counter is enabled
         if (getBit(_tac, 2)) {
-            static int kInputClockSelect[] = { 4096, 262144, 65536, 16384 };
-            static int kCyclesPerTimerCounter[] = {
-                kCPUSpeed / kInputClockSelect[0],
-                kCPUSpeed / kInputClockSelect[1],
-                kCPUSpeed / kInputClockSelect[2],
-                kCPUSpeed / kInputClockSelect[3] };
-
             _cyclesToIncTimerCounter -= nbCycles;
-            if (_cyclesToIncTimerCounter <= 0) {
+            while (_cyclesToIncTimerCounter <= 0) {
                 _cyclesToIncTimerCounter += kCyclesPerTimerCounter[_tac & 0x3];
                 ++_tima;
                 if (_tima == 0) {
-                    _memory.memoryRegister(kIF) |= Memory::kIFTimerOverflowFlag;
+                    _memory.requestInterrupt(Memory::kIFTimerOverflowFlag);
                     _tima = _tma;
                 }
             }
         }
     }
+
+    int Timers::getCyclesToNextEvent() const
+    {
+        if (!getBit(_tac, 2)) {
+            return kClockPerDividerCycle;
+        }
+        // TIMA is incremented once _cyclesToIncTimerCounter cycles have run,
+        // and then once every period until it wraps around.
+        const int period = kCyclesPerTimerCounter[_tac & 0x3];
+        return std::max(_cyclesToIncTimerCounter + (0xFF - _tima) * period, 1);
+    }
+
+    int Timers::getCyclesToNextDividerIncrement() const
+    {
+        return std::max(_cyclesToIncDivider + 1, 1);
+    }
 }
@@ -13,12 +13,17 @@ namespace gbemu {
         unsigned char readByte( unsigned short addr ) const;
         void writeByte( unsigned short addr, unsigned char value );
         void emulate( int nbCycles );
+        // Number of cycles before TIMA overflows, or a full DIV period when
+        // the timer is stopped.
+        int getCyclesToNextEvent() const;
+        int getCyclesToNextDividerIncrement() const;
 
     private:
 
         static const int kCPUSpeed = 4194304;
         static const int kDividerFrequency = 16384;
         static const int kClockPerDividerCycle = kCPUSpeed / kDividerFrequency;
+        static const int kCyclesPerTimerCounter[ 4 ];
 
         int _cyclesToIncDivider;
         int _cyclesToIncTimerCounter;
@@ -1,4 +1,6 @@
 #include <gameboy.h>
+#include <common/policy.h>
+#include <algorithm>
 
 namespace gbemu
 {
@@ -35,7 +37,16 @@ namespace gbemu
     int Gameboy::doCycle()
     {
         // emulate as many cycles as the cpu will be executing
-        const int nbCycles = _cpu.emulateCycle();
+        int nbCycles;
+        if ( EmulationPolicy::kFastForwardHalt && _cpu.isHalted() ) {
+            nbCycles = getHaltedCycles();
+        }
+        else {
+            nbCycles = EmulationPolicy::kSkipIdleLoops ? skipIdleLoop() : 0;
+            if ( nbCycles == 0 ) {
+                nbCycles = _cpu.emulateCycle();
+            }
+        }
         _clock +=nbCycles;
         // If should stop emulating, break the loop
         if ( nbCycles <= 0 ) {
@@ -44,18 +55,23 @@ namespace gbemu
         _papu.emulate( nbCycles );
         _video.emulate( nbCycles );
         _timers.emulate( nbCycles );
-        handleInterrupts();
+        if ( _memory.getPendingInterrupts() != 0 ) {
+            handleInterrupts();
+        }
         return nbCycles;
     }
 
-    Gameboy::Gameboy(const char* const bootRom) :
+    Gameboy::Gameboy(const char* const bootRom, const PixelFormat pixelFormat) :
         _clock( 4194304 ),
         _memory( _bootRom, _video, _timers, _papu ),
         _cpu( _memory, _cartridge ),
-        _video( _memory, !_bootRom.isInitialized() ),
+        _video( _memory, !_bootRom.isInitialized(), pixelFormat ),
         _papu( _clock ),
         _bootRom( bootRom ),
-        _timers( _memory )
+        _timers( _memory ),
+        _idleLoopPC( 0 ),
+        _idleLoopTime( -1 ),
+        _idleLoopDeadline( 0 )
     {}
 
     Gameboy::~Gameboy()
@@ -64,28 +80,61 @@ namespace gbemu
 
 
 
-    void Gameboy::handleInterrupts()
+    int Gameboy::getHaltedCycles()
+    {
+        // An interrupt is already pending, it will wake up the cpu right away.
+        if ( _memory.getPendingInterrupts() != 0 ) {
+            return 4;
+        }
+        // Nothing can wake up the cpu before the video or the timers raise an
+        // interrupt, so skip straight to the next of their events. Round up to
+        // the 4 cycles the cpu would have been stepping by while halted.
+        const int nbCycles = std::min( _video.getCyclesToNextEvent(), _timers.getCyclesToNextEvent() );
+        return std::max( ( nbCycles + 3 ) & ~3, 4 );
+    }
+
+    int Gameboy::skipIdleLoop()
     {
-        enum InterruptIndexes { kVBlankIndex = 0, kLCDCIndex = 1, kTimerOverflowIndex = 2, kSerialIOComplete = 3, kHighLowPin = 4 };
+        const Block* loop = _cpu.getIdleLoop();
+        if ( loop == nullptr ) {
+            return 0;
+        }
+        const int64_t now = _clock.getTimeInCycles();
+        // The previous iteration went straight through and nothing it polled
+        // changed since, so the next iterations will keep looping the same
+        // way until the deadline.
+        if ( loop->start == _idleLoopPC &&
+             now - _idleLoopTime == loop->idleLoopCycles &&
+             now < _idleLoopDeadline )
+        {
+            const int64_t iterations = ( _idleLoopDeadline - now ) / loop->idleLoopCycles;
+            if ( iterations > 0 ) {
+                // Run the loop for real once more before skipping again.
+                _idleLoopTime = -1;
+                return static_cast< int >( iterations * loop->idleLoopCycles );
+            }
+        }
 
+        int nbCycles = std::min( _video.getCyclesToNextEvent(), _timers.getCyclesToNextEvent() );
+        if ( loop->idleLoopReadsDIV ) {
+            nbCycles = std::min( nbCycles, _timers.getCyclesToNextDividerIncrement() );
+        }
+        _idleLoopPC = loop->start;
+        _idleLoopTime = now;
+        _idleLoopDeadline = now + nbCycles;
+        return 0;
+    }
+
+    void Gameboy::handleInterrupts()
+    {
         static const unsigned short interruptStartAddress [] = { 0x40, 0x48, 0x50, 0x58, 0x60 };
-      //  static const int kVBlankStartAddress = 0x40;
 
         if ( _cpu.areInterruptsEnabled() ) {
-            for ( unsigned int i = 0; i < 5; ++i ) {
-                // if interrupt is enabled and is set
-                if ( getBit( _memory.memoryRegister( kIE ), i ) &&
-                        getBit( _memory.memoryRegister( kIF ), i ) )
-                {
-                    _cpu.executeInterrupt( interruptStartAddress[ i ] );
-                    // reset the interrupt flag
-                    //resetBit( _memory._bytes[ kIF ], i );
-                    _memory.memoryRegister( kIF ) = 0;
-                    JFX_ASSERT( !_cpu.areInterruptsEnabled() );
-                    // we will be servicing an interrupt, we can't handle more for now
-                    break;
-                }
-            }
+            // The lowest bit has the highest priority.
+            const unsigned int i = countTrailingZeros( _memory.getPendingInterrupts() );
+            _cpu.executeInterrupt( interruptStartAddress[ i ] );
+            _memory.acknowledgeInterrupt( static_cast< unsigned char >( 1 << i ) );
+            JFX_ASSERT( !_cpu.areInterruptsEnabled() );
         }
     }
 }
@@ -14,7 +14,7 @@ namespace gbemu {
     class Gameboy
     {
     public:
-        Gameboy(const char* const bootRom);
+        Gameboy(const char* const bootRom, PixelFormat pixelFormat = PixelFormat::RGB888);
         ~Gameboy();
 
         Memory& getMemory();
@@ -28,6 +28,8 @@ namespace gbemu {
     private:
 
         void handleInterrupts();
+        int getHaltedCycles();
+        int skipIdleLoop();
 
         CPUClock _clock;
         BootRom _bootRom;
@@ -39,5 +41,11 @@ namespace gbemu {
         Timers _timers;
 
         VideoDisplay _video;
+
+        // Last time the cpu started an iteration of an idle loop, and the
+        // time of the next event that could change what the loop polls.
+        unsigned short _idleLoopPC;
+        int64_t        _idleLoopTime;
+        int64_t        _idleLoopDeadline;
     };
 }
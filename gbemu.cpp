@@ -22,10 +22,11 @@ namespace gbemu {
 
     std::unique_ptr< Gameboy > initGlobalEmulatorParams(
         const char* const filename,
-        const char* const bootRom
+        const char* const bootRom,
+        const PixelFormat pixelFormat
     )
     {
-        std::unique_ptr< Gameboy > gbInstance( new Gameboy( bootRom ) );
+        std::unique_ptr< Gameboy > gbInstance( new Gameboy( bootRom, pixelFormat ) );
 
         gbInstance->getCartridge().Load( filename );
         gbInstance->getMemory().loadCartridge( gbInstance->getCartridge() );
@@ -49,10 +50,7 @@ namespace gbemu {
                 break;
             }
         }
-        // FIXME: The emulator was taking a huge performance hit when saving
-        // ram to disk. Needs a better approach than the current one.
-        // Once every frame?
-        // gbInstance.getCartridge().saveRAM();
+        gbInstance.getCartridge().saveRAM();
         return frameReady;
     }
 
@@ -21,7 +21,8 @@ namespace gbemu {
 
     std::unique_ptr< Gameboy > initGlobalEmulatorParams(
         const char* const filename,
-        const char* const bootRomPath
+        const char* const bootRomPath,
+        PixelFormat pixelFormat = PixelFormat::RGB888
     );
 
     bool emulateSomeCycles( Gameboy& gb, int nbCyclesToRun );
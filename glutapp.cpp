@@ -181,6 +181,19 @@ namespace {
         writeStateToMemory();
     }
 
+#ifdef GBEMU_PROFILER
+    const size_t kProfileTopCount = 20;
+    const char* profilePath(0);
+
+    void writeProfile()
+    {
+        const Profiler& profiler( gbInstance->getCPU().getProfiler() );
+        profiler.writeReport( std::cout, kProfileTopCount );
+        std::ofstream json( profilePath );
+        profiler.writeJSON( json, kProfileTopCount );
+    }
+#endif
+
     GLuint displayTexture;
 
     void calcFPS()
@@ -221,7 +234,7 @@ namespace {
             return;
         }
         calcFPS();
-        const Color* pixels = gbInstance->getVideo().getPixels();
+        const unsigned char* pixels = gbInstance->getVideo().getPixels();
 
         glBindTexture(GL_TEXTURE_2D, displayTexture);
         JFX_CMP_ASSERT( glGetError(), ==, GL_NO_ERROR );
@@ -267,6 +280,7 @@ int main(int argc, char* argv[])
     // Extract command line arguments
     const char* cartPath(0);
     const char* bootRomPath(0);
+    bool blockExecution(false);
     // we support some -- arguments and two positional arguments.
     // -- arguments can be anywhere. Positional arguments are as follows:
     // 1) name of cartridge
@@ -274,6 +288,15 @@ int main(int argc, char* argv[])
     for (int i = 1; i < argc; ++i) {
         if (std::string(argv[i]) == "--debug") {
             Logger::enableLogger(true);
+        } else if (std::string(argv[i]) == "--block-execution") {
+            blockExecution = true;
+        } else if (std::string(argv[i]) == "--profile" && i + 1 < argc) {
+#ifdef GBEMU_PROFILER
+            profilePath = argv[++i];
+#else
+            std::cout << "gbemu was built without GBEMU_PROFILER" << std::endl;
+            return -1;
+#endif
         } else if (!cartPath) {
             cartPath = argv[i];
         } else if (!bootRomPath) {
@@ -287,6 +310,15 @@ int main(int argc, char* argv[])
     std::unique_ptr< Gameboy > gbInstanceGuard(
         gbemu::initGlobalEmulatorParams( cartPath, bootRomPath ) );
     gbInstance = gbInstanceGuard.get();
+    if (blockExecution) {
+        gbInstance->getCPU().setExecutionMode(CPU::ExecutionMode::Blocks);
+    }
+#ifdef GBEMU_PROFILER
+    // glutMainLoop never returns, report when the window is closed.
+    if (profilePath) {
+        atexit(writeProfile);
+    }
+#endif
 
     Audio audio(
         44100, &gbInstance->getPAPU(), gbInstance->getPAPU().renderAudio
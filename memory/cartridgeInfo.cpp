@@ -1,17 +1,21 @@
 #include <memory/cartridgeInfo.h>
 #include <memory/memory.h>
 #include <memory/mbc.h>
+#include <memory/romImage.h>
+#include <memory/ramWriter.h>
 
-#include <fstream>
 #include <cassert>
 
 namespace gbemu {
 
-    Cartridge::Cartridge()
+    Cartridge::Cartridge() :
+        _ramFlushInterval( 1000 )
     {}
 
     Cartridge::~Cartridge()
-    {}
+    {
+        flushRAM();
+    }
 
     std::vector< unsigned char > allocateRAM(
         unsigned char value,
@@ -38,6 +42,8 @@ namespace gbemu {
                         return std::vector< unsigned char >( 32 * 1024, 0 );
                     case 4:
                         return std::vector< unsigned char >( 128 * 1024, 0 );
+                    case 5:
+                        return std::vector< unsigned char >( 64 * 1024, 0 );
                 }
             }
         }
@@ -47,12 +53,9 @@ namespace gbemu {
 
     void Cartridge::Load( const std::string& filename )
     {
-        _bytes = readFile( filename );
-        // Validate it and allocate buffer
-        JFX_ASSERT( !_bytes.empty() );
-        JFX_CMP_ASSERT( _bytes.size(), <, 2 * 1024 * 1024 );
-
-        std::vector< unsigned char > ram;
+        _rom = ROMImage::load( filename );
+        // Validate it
+        JFX_ASSERT( _rom != nullptr );
 
         const std::string::size_type pos = filename.rfind( '.' );
         if ( pos == std::string::npos ) {
@@ -63,19 +66,23 @@ namespace gbemu {
         }
 
         // Read RAM from file
-        _ramBytes = readFile( _ramPath );
+        std::vector< unsigned char > ramBytes( readFile( _ramPath ) );
         // If nothing was read, allocate space for the RAM based on the cart info
-        if ( _ramBytes.empty() ) {
-            _ramBytes = allocateRAM( _bytes[ 0x149 ], getType() );
+        if ( ramBytes.empty() ) {
+            ramBytes = allocateRAM( getByte( 0x149 ), getType() );
         }
+        _ram.assign( std::move( ramBytes ) );
+        if ( getRAMSize() > 0 ) {
+            _ramWriter.reset( new RAMWriter( _ramPath, _ram ) );
+        }
+        _lastRAMFlush = std::chrono::steady_clock::now();
 
-
-        _mbc = MemoryBlockController::create( getType(), _bytes, _ramBytes );
+        _mbc = MemoryBlockController::create( getType(), *_rom, _ram );
 
     }
     unsigned char Cartridge::getByte( const unsigned short pos ) const
     {
-        return _bytes[ pos ];
+        return _rom->getBytes()[ pos ];
     }
     MemoryBlockController& Cartridge::getMBC()
     {
@@ -87,19 +94,36 @@ namespace gbemu {
     }
     size_t Cartridge::getROMSize() const
     {
-        return _bytes.size();
+        return _rom->getSize();
     }
     size_t Cartridge::getRAMSize() const
     {
-        return _ramBytes.size();
+        return _ram.getSize();
     }
     void Cartridge::saveRAM()
     {
-        if ( getRAMSize() > 0 ) {
-            std::ofstream fileRAM( _ramPath, std::ios::binary );
-            fileRAM.write( reinterpret_cast< const char* >( &_ramBytes.front() ),
-                           (std::streamsize)_ramBytes.size() );
+        if ( !_ram.isDirty() ) {
+            return;
         }
+        const std::chrono::steady_clock::time_point now( std::chrono::steady_clock::now() );
+        if ( now - _lastRAMFlush >= _ramFlushInterval ) {
+            flushRAM();
+            _lastRAMFlush = now;
+        }
+    }
+    void Cartridge::flushRAM()
+    {
+        if ( _ramWriter && _ram.isDirty() ) {
+            _ramWriter->write( _ram );
+        }
+    }
+    void Cartridge::setRAMFlushInterval( const int milliseconds )
+    {
+        _ramFlushInterval = std::chrono::milliseconds( milliseconds );
+    }
+    const RAMWriter* Cartridge::getRAMWriter() const
+    {
+        return _ramWriter.get();
     }
 
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory/cartridgeRAM.h>
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <string>
@@ -7,6 +9,8 @@
 namespace gbemu {
     class Memory;
     class MemoryBlockController;
+    class ROMImage;
+    class RAMWriter;
 
     class Cartridge
     {
@@ -41,11 +45,21 @@ namespace gbemu {
         Cartridge::Type getType() const;
         size_t getROMSize() const;
         size_t getRAMSize() const;
+        // Hands the pages of RAM written since the last save to the RAM
+        // writer, at most once per flush interval.
         void saveRAM();
+        // Same, without waiting for the flush interval.
+        void flushRAM();
+        void setRAMFlushInterval( int milliseconds );
+        // nullptr if the cartridge has no RAM.
+        const RAMWriter* getRAMWriter() const;
 
     private:
-        std::vector< unsigned char > _bytes;
-        std::vector< unsigned char > _ramBytes;
+        std::shared_ptr< const ROMImage > _rom;
+        CartridgeRAM _ram;
+        std::unique_ptr< RAMWriter > _ramWriter;
+        std::chrono::milliseconds _ramFlushInterval;
+        std::chrono::steady_clock::time_point _lastRAMFlush;
         std::string _cartPath;
         std::string _ramPath;
         std::unique_ptr< MemoryBlockController > _mbc;
@@ -0,0 +1,52 @@
+#include <memory/cartridgeRAM.h>
+#include <algorithm>
+
+namespace gbemu {
+
+    CartridgeRAM::CartridgeRAM() :
+        _isDirty( false )
+    {}
+
+    void CartridgeRAM::assign( std::vector< unsigned char > bytes )
+    {
+        _bytes = std::move( bytes );
+        _dirtyPages.assign( ( _bytes.size() + kPageSize - 1 ) / kPageSize, 0 );
+        _isDirty = false;
+    }
+
+    unsigned char* CartridgeRAM::getBytes()
+    {
+        return _bytes.data();
+    }
+
+    const unsigned char* CartridgeRAM::getBytes() const
+    {
+        return _bytes.data();
+    }
+
+    size_t CartridgeRAM::getSize() const
+    {
+        return _bytes.size();
+    }
+
+    bool CartridgeRAM::isDirty() const
+    {
+        return _isDirty;
+    }
+
+    bool CartridgeRAM::isPageDirty( const size_t page ) const
+    {
+        return _dirtyPages[ page ] != 0;
+    }
+
+    size_t CartridgeRAM::getPageCount() const
+    {
+        return _dirtyPages.size();
+    }
+
+    void CartridgeRAM::clearDirtyPages()
+    {
+        std::fill( _dirtyPages.begin(), _dirtyPages.end(), 0 );
+        _isDirty = false;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <common/common.h>
+#include <vector>
+
+namespace gbemu {
+
+    // External RAM of a cartridge. Keeps track of the pages written since
+    // they were last saved.
+    class CartridgeRAM
+    {
+    public:
+        static const size_t kPageSize = 256;
+
+        CartridgeRAM();
+        void assign( std::vector< unsigned char > bytes );
+
+        unsigned char* getBytes();
+        const unsigned char* getBytes() const;
+        size_t getSize() const;
+
+        JFX_INLINE void markDirty( size_t offset );
+        bool isDirty() const;
+        bool isPageDirty( size_t page ) const;
+        size_t getPageCount() const;
+        void clearDirtyPages();
+
+    private:
+        std::vector< unsigned char > _bytes;
+        std::vector< unsigned char > _dirtyPages;
+        bool                         _isDirty;
+    };
+
+    void CartridgeRAM::markDirty( const size_t offset )
+    {
+        _dirtyPages[ offset / kPageSize ] = 1;
+        _isDirty = true;
+    }
+}
@@ -9,273 +9,9 @@
 #include <memory/mbc.h>
 #include <memory/memory.h>
 #include <memory/cartridgeInfo.h>
-
-namespace {
-    using namespace gbemu;
-
-    class MBCBase : public MemoryBlockController
-    {
-    public:
-        MBCBase(
-            std::vector< unsigned char >& rom,
-            std::vector< unsigned char >& ram
-        ) : _rom( rom ),
-            _ram( ram )
-        {}
-
-        void writeRAMByte( int index, unsigned char value )
-        {
-            if ( getRAMSize() == 0 ) {
-                return;
-            }
-            _ram.at( (size_t)(index % getRAMSize()) ) = value;
-        }
-        unsigned char readRAMByte( const int index ) const
-        {
-           if ( getRAMSize() == 0 ) {
-                return 0;
-            }
-            return _ram.at( (size_t)(index % getRAMSize()) );
-        }
-        void writeROMByte( int index, unsigned char value )
-        {
-            _rom.at( (size_t)(index % getROMSize()) ) = value;
-        }
-        unsigned char readROMByte( const int index ) const
-        {
-            return _rom.at( (size_t)(index % getROMSize()) );
-        }
-        int getRAMSize() const
-        {
-            return (int)_ram.size();
-        }
-        int getROMSize() const
-        {
-            return (int)_rom.size();
-        }
-
-    private:
-        std::vector< unsigned char >& _rom;
-        std::vector< unsigned char >& _ram;
-    };
-
-    class MBC1 : public MBCBase
-    {
-    public:
-
-        enum class Mode { _16_8, _4_32 };
-
-        MBC1(
-            std::vector< unsigned char >& rom,
-            std::vector< unsigned char >& ram
-        ) : MBCBase( rom, ram ),
-            _mode( Mode::_16_8 ),
-            _lowerRomBankBits( 0 ),
-            _romRamBits( 0 ),
-            _externalRAMEnabled( false )
-        {}
-
-        Type getType() const
-        {
-            return Type::MBC1;
-        }
-
-        const char* getName() const
-        {
-            return "MBC1";
-        }
-
-        virtual void writeByte(
-            unsigned short addr,
-            unsigned char value
-        )
-        {
-            // rom bank 0, lower 16k
-            if ( addr < 0x2000 ) {
-                // Do we really care?
-                _externalRAMEnabled = ( ( value & 0x0A ) == 0x0A );
-            }
-            // rom bank 0, upper 16k
-            else if ( addr >= 0x2000 && addr < 0x4000 ) {
-                _lowerRomBankBits = value & GetMask( 0, 0, 0, 1, 1, 1, 1, 1 );
-            }
-            // switchable rom bank writing, lower 16k
-            else if ( addr >= 0x4000 && addr < 0x6000 ) {
-                _romRamBits = value & 0x3;
-            }
-            // switchable rom bank writing, upper 16k
-            else if ( addr >= 0x6000 && addr < 0x8000 ) {
-                _mode = getBit( value, 0 ) ? Mode::_4_32 : Mode::_16_8;
-            }
-            else if ( Memory::isSwitchableRAMBank( addr ) ) {
-                if ( !_externalRAMEnabled ) {
-                    return;
-                }
-                if ( _mode == Mode::_16_8 ) {
-                    writeRAMByte( addr - 0xa000, value );
-                }
-                else {
-                    writeRAMByte( ( addr - 0xa000 ) + _romRamBits * 8 * 1024, value );
-                }
-            }
-            else {
-                JFX_MSG_ABORT( "Write at " << addr << " not supported for MBC1" );
-            }
-        }
-
-        virtual unsigned char readByte(
-            unsigned short addr
-        ) const
-        {
-            if ( Memory::isROMBank0( addr ) ) {
-                return readROMByte( addr );
-            }
-            else if ( Memory::isSwitchableROMBank( addr ) ) {
-                if ( _mode == Mode::_16_8 ) {
-                    return readROMByte(
-                        ( ( ( _romRamBits << 5 ) | _lowerRomBankBits ) * 16 * 1024 ) |
-                        ( addr - Memory::getSwitchableROMBankStart() )
-                    );
-                }
-                else {
-                    return readROMByte(
-                        ( _lowerRomBankBits * 16 * 1024 ) |
-                        ( addr - Memory::getSwitchableROMBankStart() )
-                    );
-                }
-            }
-            else if ( Memory::isSwitchableRAMBank( addr ) ) {
-                if ( !_externalRAMEnabled ) {
-                    return 0;
-                }
-                if ( _mode == Mode::_16_8 ) {
-                    return readRAMByte( addr - 0xa000 );
-                }
-                else {
-                    return readRAMByte( ( addr - 0xa000 ) + _romRamBits * 8 * 1024 );
-                }
-            }
-            else {
-                JFX_MSG_ABORT( "Reading at " << addr << " for MBC1 not supported." );
-            }
-        }
-
-    private:
-        Mode _mode;
-        int  _romRamBits;
-        int  _lowerRomBankBits;
-        bool _externalRAMEnabled;
-    };
-
-    class MBC2 : public MBCBase
-    {
-    public:
-
-        MBC2(
-            std::vector< unsigned char >& rom,
-            std::vector< unsigned char >& ram
-        ) : MBCBase( rom, ram ),
-            _romBankIndex( 0 ),
-            _externalRAMEnabled( false )
-        {}
-
-        Type getType() const
-        {
-            return Type::MBC2;
-        }
-
-        const char* getName() const
-        {
-            return "MBC2";
-        }
-
-        virtual void writeByte(
-            unsigned short addr,
-            unsigned char value
-        )
-        {
-            // rom bank 0, lower 16k
-            if ( addr < 0x2000 ) {
-                // Do we really care?
-                _externalRAMEnabled = ( ( value & 0x0A ) == 0x0A );
-            }
-            else if ( addr >= 0x2000 && addr < 0x4000 ) {
-                _romBankIndex = value & GetMask( 0, 0, 0, 0, 1, 1, 1, 1 );
-            }
-            else if ( Memory::isSwitchableRAMBank( addr ) ) {
-                if ( !_externalRAMEnabled ) {
-                    return;
-                }
-                writeRAMByte( addr - 0xa000, value );
-            }
-            else {
-                JFX_MSG_ABORT( "Write at " << addr << " not supported for MBC2" );
-            }
-        }
-
-        virtual unsigned char readByte(
-            unsigned short addr
-        ) const
-        {
-            if ( Memory::isROMBank0( addr ) ) {
-                return readROMByte( addr );
-            }
-            else if ( Memory::isSwitchableROMBank( addr ) ) {
-                return readROMByte(
-                    ( ( _romBankIndex ) * 16 * 1024 ) |
-                    ( addr - Memory::getSwitchableROMBankStart() )
-                );
-            }
-            else if ( Memory::isSwitchableRAMBank( addr ) ) {
-                if ( !_externalRAMEnabled ) {
-                    return 0;
-                }
-                return readRAMByte( addr - 0xa000 );
-            }
-            else {
-                JFX_MSG_ABORT( "Reading at " << addr << " for MBC2 not supported." );
-            }
-        }
-
-    private:
-        int  _romBankIndex;
-        bool _externalRAMEnabled;
-    };
-
-    class NoMBC : public MBCBase
-    {
-    public:
-        NoMBC(
-            std::vector< unsigned char >& rom,
-            std::vector< unsigned char >& ram
-        ) : MBCBase( rom, ram )
-        {}
-
-        Type getType() const
-        {
-            return Type::None;
-        }
-        const char* getName() const
-        {
-            return "None";
-        }
-        void writeByte(
-            unsigned short,
-            unsigned char
-        )
-        {
-            // FIXME: Had to deactivate this. Maybe it should only
-            // be a warning?
-            //JFX_MSG_ABORT( "Not supposed to write to None MBC" );
-        }
-        virtual unsigned char readByte(
-            unsigned short addr
-        ) const
-        {
-            return readROMByte( addr );
-        }
-    };
-}
+#include <memory/romImage.h>
+#include <memory/cartridgeRAM.h>
+#include <algorithm>
 
 namespace gbemu {
 
@@ -287,40 +23,44 @@ namespace gbemu {
 
     std::unique_ptr< MemoryBlockController > MemoryBlockController::create(
         Cartridge::Type type,
-        std::vector< unsigned char >& rom,
-        std::vector< unsigned char >& ram
+        const ROMImage& rom,
+        CartridgeRAM& ram
     )
     {
         switch( type ) {
             case Cartridge::kROM_ONLY:
             case Cartridge::kROM_RAM:
             case Cartridge::kROM_RAM_BATTERY:
-                return make_unique( new NoMBC( rom, ram ) );
+                return make_unique( new MemoryBlockController( Type::None, rom, ram ) );
             case Cartridge::kROM_MBC1:
             case Cartridge::kROM_MBC1_RAM:
             case Cartridge::kROM_MBC1_RAM_BATT:
-                return make_unique( new MBC1( rom, ram ) );
+                return make_unique( new MemoryBlockController( Type::MBC1, rom, ram ) );
 
             case Cartridge::kROM_MBC2:
             case Cartridge::kROM_MBC2_BATTERY:
-                return make_unique( new MBC2( rom, ram ) );
-
-            case Cartridge::kROM_MMM01:
-            case Cartridge::kROM_MMM01_SRAM:
-            case Cartridge::kROM_MMM01_SRAM_BATT:
+                return make_unique( new MemoryBlockController( Type::MBC2, rom, ram ) );
 
+            // The real time clock isn't emulated, its registers read as 0.
             case Cartridge::kROM_MBC3:
             case Cartridge::kROM_MBC3_RAM:
             case Cartridge::kROM_MBC3_RAM_BATT:
             case Cartridge::kROM_MBC3_TIMER_BATT:
             case Cartridge::kROM_MBC3_TIMER_RAM_BATT:
+                return make_unique( new MemoryBlockController( Type::MBC3, rom, ram ) );
 
+            // The rumble motor is ignored.
             case Cartridge::kROM_MBC5:
             case Cartridge::kROM_MBC5_RAM:
             case Cartridge::kROM_MBC5_RAM_BATT:
             case Cartridge::kROM_MBC5_RUMBLE:
             case Cartridge::kROM_MBC5_RUMBLE_SRAM:
             case Cartridge::kROM_MBC5_RUMBLE_SRAM_BATT:
+                return make_unique( new MemoryBlockController( Type::MBC5, rom, ram ) );
+
+            case Cartridge::kROM_MMM01:
+            case Cartridge::kROM_MMM01_SRAM:
+            case Cartridge::kROM_MMM01_SRAM_BATT:
 
             case Cartridge::kPocketCamera:
             case Cartridge::kBandaiTAMA5:
@@ -332,4 +72,230 @@ namespace gbemu {
                 JFX_MSG_ABORT("Unknown memory block controller" << std::hex << std::endl)
         }
     }
+
+    MemoryBlockController::MemoryBlockController(
+        const Type type,
+        const ROMImage& rom,
+        CartridgeRAM& ram
+    ) : _type( type ),
+        _rom( rom ),
+        _ram( ram ),
+        _ramMask( std::min( getRAMSize(), kRAMBankSize ) - 1 ),
+        _romBank0( getROMBankBytes( 0 ) ),
+        _romBank( nullptr ),
+        _ramBank( nullptr ),
+        _ramBankOffset( 0 ),
+        _romBankIndex( 0 ),
+        _ramBankIndex( 0 ),
+        _isRAMBankingMode( false ),
+        // Without a controller, the RAM, if there is any, is always enabled.
+        _isRAMEnabled( type == Type::None )
+    {
+        JFX_CMP_ASSERT( getROMSize() % kROMBankSize, ==, 0 );
+        mapBanks();
+    }
+
+    const char* MemoryBlockController::getName() const
+    {
+        switch ( _type ) {
+            case Type::None:
+                return "None";
+            case Type::MBC1:
+                return "MBC1";
+            case Type::MBC2:
+                return "MBC2";
+            case Type::MBC3:
+                return "MBC3";
+            case Type::MBC5:
+                return "MBC5";
+            case Type::MMM01:
+                return "MMM01";
+        }
+        return "Unknown";
+    }
+
+    MemoryBlockController::Type MemoryBlockController::getType() const
+    {
+        return _type;
+    }
+
+    void MemoryBlockController::writeByte(
+        const unsigned short addr,
+        const unsigned char value
+    )
+    {
+        if ( Memory::isSwitchableRAMBank( addr ) ) {
+            writeRAMByte( addr, value );
+            return;
+        }
+        JFX_CMP_ASSERT( addr, <, 0x8000 );
+        switch ( _type ) {
+            case Type::MBC1:
+                writeMBC1Register( addr, value );
+                break;
+            case Type::MBC2:
+                writeMBC2Register( addr, value );
+                break;
+            case Type::MBC3:
+                writeMBC3Register( addr, value );
+                break;
+            case Type::MBC5:
+                writeMBC5Register( addr, value );
+                break;
+            default:
+                // FIXME: Had to deactivate this. Maybe it should only
+                // be a warning?
+                //JFX_MSG_ABORT( "Not supposed to write to None MBC" );
+                return;
+        }
+        mapBanks();
+    }
+
+    void MemoryBlockController::writeMBC1Register(
+        const unsigned short addr,
+        const unsigned char value
+    )
+    {
+        // rom bank 0, lower 16k
+        if ( addr < 0x2000 ) {
+            // Do we really care?
+            _isRAMEnabled = ( ( value & 0x0A ) == 0x0A );
+        }
+        // rom bank 0, upper 16k
+        else if ( addr < 0x4000 ) {
+            _romBankIndex = value & GetMask( 0, 0, 0, 1, 1, 1, 1, 1 );
+        }
+        // switchable rom bank writing, lower 16k
+        else if ( addr < 0x6000 ) {
+            _ramBankIndex = value & 0x3;
+        }
+        // switchable rom bank writing, upper 16k
+        else {
+            _isRAMBankingMode = getBit( value, 0 );
+        }
+    }
+
+    void MemoryBlockController::writeMBC2Register(
+        const unsigned short addr,
+        const unsigned char value
+    )
+    {
+        // rom bank 0, lower 16k
+        if ( addr < 0x2000 ) {
+            // Do we really care?
+            _isRAMEnabled = ( ( value & 0x0A ) == 0x0A );
+        }
+        else if ( addr < 0x4000 ) {
+            _romBankIndex = value & GetMask( 0, 0, 0, 0, 1, 1, 1, 1 );
+        }
+        else {
+            JFX_MSG_ABORT( "Write at " << addr << " not supported for MBC2" );
+        }
+    }
+
+    void MemoryBlockController::writeMBC3Register(
+        const unsigned short addr,
+        const unsigned char value
+    )
+    {
+        if ( addr < 0x2000 ) {
+            _isRAMEnabled = ( value & 0x0F ) == 0x0A;
+        }
+        else if ( addr < 0x4000 ) {
+            _romBankIndex = value & 0x7F;
+        }
+        // RAM banks 0 to 3, or 8 to 0xC for the clock registers.
+        else if ( addr < 0x6000 ) {
+            _ramBankIndex = value & 0x0F;
+        }
+        // Writes 0 then 1 to latch the clock.
+    }
+
+    void MemoryBlockController::writeMBC5Register(
+        const unsigned short addr,
+        const unsigned char value
+    )
+    {
+        if ( addr < 0x2000 ) {
+            _isRAMEnabled = ( value & 0x0F ) == 0x0A;
+        }
+        // The ROM bank has 9 bits, the 9th is written separately.
+        else if ( addr < 0x3000 ) {
+            _romBankIndex = ( _romBankIndex & 0x100 ) | value;
+        }
+        else if ( addr < 0x4000 ) {
+            _romBankIndex = ( _romBankIndex & 0xFF ) | ( ( value & 0x1 ) << 8 );
+        }
+        else if ( addr < 0x6000 ) {
+            _ramBankIndex = value & 0x0F;
+        }
+    }
+
+    void MemoryBlockController::writeRAMByte( const unsigned short addr, const unsigned char value )
+    {
+        if ( _ramBank == nullptr ) {
+            return;
+        }
+        const int offset = ( addr - 0xA000 ) & _ramMask;
+        _ramBank[ offset ] = value;
+        _ram.markDirty( (size_t)( _ramBankOffset + offset ) );
+    }
+
+    int MemoryBlockController::getSwitchableROMBank() const
+    {
+        switch ( _type ) {
+            case Type::None:
+                return 1;
+            case Type::MBC1:
+                return _isRAMBankingMode ? _romBankIndex : ( _ramBankIndex << 5 ) | _romBankIndex;
+            case Type::MBC3:
+                // Bank 0 can't be mapped twice.
+                return _romBankIndex == 0 ? 1 : _romBankIndex;
+            default:
+                return _romBankIndex;
+        }
+    }
+
+    const unsigned char* MemoryBlockController::getROMBankBytes( const int bank ) const
+    {
+        return _rom.getBytes() + (size_t)( bank % ( getROMSize() / kROMBankSize ) ) * kROMBankSize;
+    }
+
+    const unsigned char* MemoryBlockController::getRAMBankBytes() const
+    {
+        return _ramMask == kRAMBankSize - 1 ? _ramBank : nullptr;
+    }
+
+    // Resolves the banks once when their registers are written, instead of
+    // on every access.
+    void MemoryBlockController::mapBanks()
+    {
+        _romBank = getROMBankBytes( getSwitchableROMBank() );
+
+        int ramBank = _ramBankIndex;
+        bool isRAMMapped = _isRAMEnabled && getRAMSize() != 0;
+        if ( _type == Type::MBC1 ) {
+            ramBank = _isRAMBankingMode ? _ramBankIndex : 0;
+        }
+        else if ( _type == Type::MBC3 ) {
+            isRAMMapped = isRAMMapped && _ramBankIndex < 4;
+        }
+        if ( !isRAMMapped ) {
+            _ramBank = nullptr;
+        }
+        else {
+            _ramBankOffset = ( ramBank * kRAMBankSize ) % getRAMSize();
+            _ramBank = _ram.getBytes() + _ramBankOffset;
+        }
+    }
+
+    int MemoryBlockController::getROMSize() const
+    {
+        return (int)_rom.getSize();
+    }
+
+    int MemoryBlockController::getRAMSize() const
+    {
+        return (int)_ram.getSize();
+    }
 }
@@ -9,6 +9,7 @@
 #ifndef gbemu_mbc_h
 #define gbemu_mbc_h
 
+#include <common/common.h>
 #include <memory/cartridgeInfo.h>
 #include <memory>
 #include <vector>
@@ -16,30 +17,94 @@
 namespace gbemu {
 
     class Memory;
+    class ROMImage;
+    class CartridgeRAM;
 
+    // The controllers only differ by how they decode the writes to their
+    // registers into banks. The banks are resolved when the registers are
+    // written, so reading is the same for all of them and doesn't need to
+    // be dispatched on the type.
     class MemoryBlockController
     {
     public:
         enum class Type { None, MBC1, MBC2, MBC3, MBC5, MMM01 };
 
+        static const int kROMBankSize = 16 * 1024;
+        static const int kRAMBankSize = 8 * 1024;
+
         static std::unique_ptr< MemoryBlockController > create(
             Cartridge::Type type,
-            std::vector< unsigned char >& rom,
-            std::vector< unsigned char >& ram
+            const ROMImage& rom,
+            CartridgeRAM& ram
+        );
+
+        MemoryBlockController(
+            Type type,
+            const ROMImage& rom,
+            CartridgeRAM& ram
         );
 
-        virtual const char* getName() const = 0;
-        virtual Type getType() const = 0;
+        const char* getName() const;
+        Type getType() const;
 
-        virtual void writeByte(
+        void writeByte(
             unsigned short addr,
             unsigned char value
-        ) = 0;
-        virtual unsigned char readByte(
+        );
+        JFX_INLINE unsigned char readByte(
             unsigned short addr
-        ) const = 0;
+        ) const;
+        // Index of the bank currently mapped at 0x4000-0x7FFF.
+        int getSwitchableROMBank() const;
+        // The 16k bytes of a ROM bank.
+        const unsigned char* getROMBankBytes( int bank ) const;
+        // The 8k bytes of the RAM bank mapped at 0xA000-0xBFFF, nullptr if
+        // the RAM is disabled or smaller than a bank.
+        const unsigned char* getRAMBankBytes() const;
+
+    private:
+        void writeMBC1Register( unsigned short addr, unsigned char value );
+        void writeMBC2Register( unsigned short addr, unsigned char value );
+        void writeMBC3Register( unsigned short addr, unsigned char value );
+        void writeMBC5Register( unsigned short addr, unsigned char value );
+        void writeRAMByte( unsigned short addr, unsigned char value );
+        // Resolves the banks selected by the registers.
+        void mapBanks();
+        int getROMSize() const;
+        int getRAMSize() const;
+
+        const Type                    _type;
+        const ROMImage&               _rom;
+        CartridgeRAM&                 _ram;
+        int                           _ramMask;
+        const unsigned char*          _romBank0;
+        const unsigned char*          _romBank;
+        unsigned char*                _ramBank;
+        int                           _ramBankOffset;
+        // Registers
+        int                           _romBankIndex;
+        int                           _ramBankIndex;
+        // MBC1 only, the upper bits of the bank select the RAM bank
+        // instead of the ROM bank.
+        bool                          _isRAMBankingMode;
+        bool                          _isRAMEnabled;
     };
 
+    unsigned char MemoryBlockController::readByte(
+        const unsigned short addr
+    ) const
+    {
+        if ( addr < 0x4000 ) {
+            return _romBank0[ addr ];
+        }
+        if ( addr < 0x8000 ) {
+            return _romBank[ addr & 0x3FFF ];
+        }
+        if ( _ramBank == nullptr ) {
+            return 0;
+        }
+        return _ramBank[ ( addr - 0xA000 ) & _ramMask ];
+    }
 }
 
 #endif
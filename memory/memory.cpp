@@ -5,6 +5,10 @@
 #include <audio/papu.h>
 #include <video/videoDisplay.h>
 #include <cpu/timers.h>
+#include <cpu/blockCache.h>
+#include <cpu/cpu.h>
+#include <memory/memoryHook.h>
+#include <base/clock.h>
 #include <memory>
 
 namespace gbemu {
@@ -30,6 +34,11 @@ namespace gbemu {
         return isBetween( addr, 0xE000, 0xFE00 );
     }
 
+    bool Memory::isHighRAM( unsigned short addr )
+    {
+        return isBetween( addr, 0xFF80, kIE );
+    }
+
     bool Memory::isMemoryMapped( unsigned short addr )
     {
         return isROMBank0( addr ) ||
@@ -51,18 +60,101 @@ namespace gbemu {
         _videoDisplay( videoDisplay ),
         _isBooting( bootRom.isInitialized() ),
         _papu( papu ),
-        _timers( timers )
+        _timers( timers ),
+        _blockCache( nullptr ),
+        _pendingInterrupts( 0 ),
+        _isDMAActive( false ),
+        _romBank0( nullptr ),
+        _switchableROMBank( nullptr ),
+        _cartridgeRAMBank( nullptr ),
+        _videoRAM( nullptr ),
+        _hook( nullptr ),
+        _clock( nullptr ),
+        _cpu( nullptr )
     {
-        memset( _bytes, 0, sizeof( _bytes ) );
-        _bytes[ kP1 ] = 0xff;
+        memset( &_internalRAM.byte( 0xC000 ), 0, 0xE000 - 0xC000 );
+        memset( &_registers.byte( 0xFF00 ), 0, 0x10000 - 0xFF00 );
+        _registers.byte( kP1 ) = 0xff;
         if (!hasBootRom()) {
-            memoryRegister(kIE) = 0x00;
+            _registers.byte( kIE ) = 0x00;
+        }
+        memset( _pageFlags, 0, sizeof( _pageFlags ) );
+        for ( int page = 0; page < kPageCount; ++page ) {
+            mapPage( page );
         }
     }
 
     void Memory::loadCartridge( Cartridge& cartridge )
     {
         _cartridge = &cartridge;
+        mapCartridgePages();
+        // The video display is constructed after the memory, so its RAM is
+        // only mapped now.
+        _videoRAM = _videoDisplay.getVideoRAM();
+        for ( int page = 0x80; page < 0xA0; ++page ) {
+            mapPage( page );
+        }
+    }
+
+    void Memory::mapCartridgePages()
+    {
+        const MemoryBlockController& mbc( _cartridge->getMBC() );
+        _romBank0 = mbc.getROMBankBytes( 0 );
+        _switchableROMBank = mbc.getROMBankBytes( mbc.getSwitchableROMBank() );
+        _cartridgeRAMBank = mbc.getRAMBankBytes();
+        for ( int page = 0; page < 0x80; ++page ) {
+            mapPage( page );
+        }
+        for ( int page = 0xA0; page < 0xC0; ++page ) {
+            mapPage( page );
+        }
+    }
+
+    void Memory::mapPage( const int page )
+    {
+        const unsigned char* readBytes = nullptr;
+        unsigned char* writeBytes = nullptr;
+        if ( page < 0x40 ) {
+            // The boot rom hides the start of the cartridge until it is done.
+            if ( _romBank0 != nullptr && !( _isBooting && page <= _bootRom.getLastByteAddr() >> 8 ) ) {
+                readBytes = _romBank0 + page * kPageSize;
+            }
+        }
+        else if ( page < 0x80 ) {
+            if ( _switchableROMBank != nullptr ) {
+                readBytes = _switchableROMBank + ( page - 0x40 ) * kPageSize;
+            }
+        }
+        else if ( page < 0xA0 ) {
+            if ( _videoRAM != nullptr ) {
+                readBytes = _videoRAM + ( page - 0x80 ) * kPageSize;
+                // The tile data is written through the video display, so it
+                // can decode the tiles again.
+                if ( page >= VideoDisplay::kTileMapStart >> 8 ) {
+                    writeBytes = _videoRAM + ( page - 0x80 ) * kPageSize;
+                }
+            }
+        }
+        else if ( page < 0xC0 ) {
+            // The writes have to go through the controller so it can track
+            // the bytes to save.
+            if ( _cartridgeRAMBank != nullptr ) {
+                readBytes = _cartridgeRAMBank + ( page - 0xA0 ) * kPageSize;
+            }
+        }
+        else if ( page >= 0xC0 && page < 0xFE ) {
+            // The echo pages share the bytes of the internal RAM.
+            writeBytes = &_internalRAM.byte( ( page < 0xE0 ? page : page - 0x20 ) * kPageSize );
+        }
+        if ( readBytes == nullptr ) {
+            readBytes = writeBytes;
+        }
+        if ( _isDMAActive ) {
+            readBytes = nullptr;
+            writeBytes = nullptr;
+        }
+        _readPages[ page ] = ( _pageFlags[ page ] & kWatchReads ) == 0 ? readBytes : nullptr;
+        _writePages[ page ] = ( _pageFlags[ page ] & ( kWatchWrites | kCodePage ) ) == 0 ? writeBytes : nullptr;
     }
 
     void Memory::setKeyState( unsigned char state )
@@ -70,21 +162,39 @@ namespace gbemu {
         _keyState = state;
     }
 
-    unsigned char Memory::readByte( unsigned short addr ) const
+    unsigned char Memory::readSlowByte( const unsigned short addr ) const
+    {
+        const unsigned char value = readUnmappedByte( addr );
+        if ( ( _pageFlags[ addr >> 8 ] & kWatchReads ) != 0 ) {
+            recordAccess( addr, value, false );
+        }
+        return value;
+    }
+
+    unsigned char Memory::readUnmappedByte( unsigned short addr ) const
     {
+        if ( _isDMAActive && addr < 0xFF00 ) {
+            return 0xFF;
+        }
         // When we are booting, the first 256 bytes are in the boot rom
         if ( _isBooting && addr <= _bootRom.getLastByteAddr() ) {
             const unsigned char oneByte = _bootRom.readByte( addr );
             if ( _bootRom.getLastByteAddr() == addr ) {
                 _isBooting = false;
+                // Reading is otherwise const, the page table is only a cache
+                // of where the bytes are.
+                const_cast< Memory* >( this )->mapCartridgePages();
             }
             return oneByte;
         }
         if ( isMemoryMapped( addr ) ) {
             return _cartridge->getMBC().readByte( addr );
         }
+        if ( isInternalRAM( addr ) ) {
+            return _internalRAM.byte( addr );
+        }
         if ( isInternalRAMEcho( addr ) ) {
-            return _bytes[addr - 0x2000];
+            return _internalRAM.byte( addr - 0x2000 );
         }
         if ( VideoDisplay::isVideoMemory( addr ) ) {
             return _videoDisplay.readByte( addr );
@@ -95,33 +205,174 @@ namespace gbemu {
         if ( _timers.contains( addr ) ) {
             return _timers.readByte( addr );
         }
-        return _bytes[ addr ];
+        // Nothing is wired between the OAM and the IO registers.
+        if ( addr < 0xFF00 ) {
+            return 0;
+        }
+        return _registers.byte( addr );
     }
 
-    unsigned char& Memory::memoryRegister( unsigned short addr )
+    bool Memory::hasBootRom() const
     {
-        return _bytes[ addr ];
+        return _bootRom.isInitialized();
     }
 
-    bool Memory::hasBootRom() const
+    bool Memory::isInBootRom( unsigned short addr ) const
     {
-        return _bootRom.isInitialized();
+        return _isBooting && addr <= _bootRom.getLastByteAddr();
+    }
+
+    int Memory::getSwitchableROMBank() const
+    {
+        return _cartridge->getMBC().getSwitchableROMBank();
+    }
+
+    void Memory::setBlockCache( BlockCache* blockCache )
+    {
+        _blockCache = blockCache;
+    }
+
+    void Memory::requestInterrupt( const unsigned char flag )
+    {
+        _registers.byte( kIF ) |= flag;
+        updatePendingInterrupts();
+    }
+
+    void Memory::acknowledgeInterrupt( const unsigned char flag )
+    {
+        _registers.byte( kIF ) &= ~flag;
+        updatePendingInterrupts();
     }
 
-    void Memory::writeByte( unsigned short addr, unsigned char value )
+    void Memory::updatePendingInterrupts()
+    {
+        _pendingInterrupts = _registers.byte( kIE ) & _registers.byte( kIF ) & 0x1F;
+    }
+
+    void Memory::setCodePage( const int page, const bool hasCode )
+    {
+        if ( !isInternalRAM( static_cast< unsigned short >( page * kPageSize ) ) ) {
+            return;
+        }
+        // The page and its echo.
+        for ( int mirror = page; mirror < 0xFE; mirror += 0x20 ) {
+            if ( hasCode ) {
+                _pageFlags[ mirror ] |= kCodePage;
+            }
+            else {
+                _pageFlags[ mirror ] &= ~kCodePage;
+            }
+            mapPage( mirror );
+        }
+    }
+
+    void Memory::readBytes( const unsigned short addr, unsigned char* const bytes, const size_t count ) const
+    {
+        const unsigned char* const page = _readPages[ addr >> 8 ];
+        if ( page != nullptr && ( addr & 0xFF ) + count <= size_t( kPageSize ) ) {
+            memcpy( bytes, page + ( addr & 0xFF ), count );
+            return;
+        }
+        for ( size_t i = 0; i < count; ++i ) {
+            bytes[ i ] = readByte( static_cast< unsigned short >( addr + i ) );
+        }
+    }
+
+    void Memory::setDMAActive( const bool isActive )
+    {
+        _isDMAActive = isActive;
+        for ( int page = 0; page < kPageCount; ++page ) {
+            mapPage( page );
+        }
+    }
+
+    void Memory::setHook( MemoryHook* const hook, const CPUClock* const clock, const CPU* const cpu )
+    {
+        _hook = hook;
+        _clock = clock;
+        _cpu = cpu;
+    }
+
+    void Memory::watch( const unsigned short first, const unsigned short last, const bool reads, const bool writes )
+    {
+        JFX_CMP_ASSERT( first, <=, last );
+        const Watch watch = { first, last, reads, writes };
+        _watches.push_back( watch );
+        for ( int page = first >> 8; page <= last >> 8; ++page ) {
+            _pageFlags[ page ] |= ( reads ? kWatchReads : 0 ) | ( writes ? kWatchWrites : 0 );
+            mapPage( page );
+        }
+    }
+
+    void Memory::clearWatches()
+    {
+        _watches.clear();
+        for ( int page = 0; page < kPageCount; ++page ) {
+            _pageFlags[ page ] &= ~( kWatchReads | kWatchWrites );
+            mapPage( page );
+        }
+    }
+
+    void Memory::recordAccess( const unsigned short addr, const unsigned char value, const bool isWrite ) const
+    {
+        if ( _hook == nullptr ) {
+            return;
+        }
+        for ( size_t i = 0; i < _watches.size(); ++i ) {
+            const Watch& watch( _watches[ i ] );
+            if ( watch.first <= addr && addr <= watch.last && ( isWrite ? watch.writes : watch.reads ) ) {
+                const MemoryAccess access = {
+                    _clock->getTimeInCycles() + _cpu->getInstructionCycles(),
+                    _cpu->getInstructionPC(),
+                    addr,
+                    value,
+                    isWrite
+                };
+                _hook->record( access );
+                return;
+            }
+        }
+    }
+
+    void Memory::writeSlowByte( const unsigned short addr, const unsigned char value )
+    {
+        if ( ( _pageFlags[ addr >> 8 ] & kWatchWrites ) != 0 ) {
+            recordAccess( addr, value, true );
+        }
+        writeUnmappedByte( addr, value );
+    }
+
+    void Memory::writeUnmappedByte( unsigned short addr, unsigned char value )
     {
         using namespace cartridgeInfo;
+        if ( _isDMAActive && addr < 0xFF00 ) {
+            return;
+        }
         if ( isMemoryMapped( addr ) ) {
             _cartridge->getMBC().writeByte( addr, value );
+            // The ROM bank might have been switched under the CPU's feet, and
+            // the RAM bank enabled or switched.
+            if ( addr < 0x8000 ) {
+                mapCartridgePages();
+                if ( _blockCache ) {
+                    _blockCache->resetCursor();
+                }
+            }
         }
         else if ( isInternalRAM( addr ) ) {
-            _bytes[addr] = value;
+            _internalRAM.byte( addr ) = value;
+            if ( _blockCache ) {
+                _blockCache->invalidate( addr );
+            }
         }
         else if ( isInternalRAMEcho( addr ) ) {
-            _bytes[addr - 0x2000] = value;
+            _internalRAM.byte( addr - 0x2000 ) = value;
+            if ( _blockCache ) {
+                _blockCache->invalidate( addr - 0x2000 );
+            }
         }
         else if ( isBetween( addr, 0xFEA0, 0xff00 ) ) {
-            _bytes[addr] = value;
+            // Nothing is wired between the OAM and the IO registers.
         }
         else if (VideoDisplay::isVideoMemory(addr)) {
             _videoDisplay.writeByte( addr, value );
@@ -143,34 +394,39 @@ P12-------O-Up-------O-Select --- bit 2
 P13-------O-Down-----O-Start ---- bit 3
 */
                 if ( !getBit( value, 4 ) ) {
-                    _bytes[ kP1 ] = 0xc0 | ( value & 0x30 ) | ( (~_keyState) & 0x0F );
+                    _registers.byte( kP1 ) = 0xc0 | ( value & 0x30 ) | ( (~_keyState) & 0x0F );
                 }
                 if ( !getBit( value, 5 ) ) {
-                    _bytes[ kP1 ] = 0xc0 | ( value & 0x30 ) | ( ( ~_keyState >> 4 ) & 0x0F );
+                    _registers.byte( kP1 ) = 0xc0 | ( value & 0x30 ) | ( ( ~_keyState >> 4 ) & 0x0F );
                 }
 
             }
             else if ( addr == kSB ) {
-                _bytes[ addr ] = value;
+                _registers.byte( addr ) = value;
             }
             else if ( addr == kSC ) {
-                _bytes[ addr ] = value;
+                _registers.byte( addr ) = value;
             }
             else if ( addr == kIF ) {
-                _bytes[ addr ] = value;
+                _registers.byte( addr ) = value;
+                updatePendingInterrupts();
             }
             else if ( _papu.contains( addr ) ) {
                 _papu.writeByte( addr, value );
             }
             else {
-                _bytes[ addr ] = value;
+                _registers.byte( addr ) = value;
             }
         }
         else if ( addr < 0xffff ) {
-            _bytes[ addr ] = value;
+            _registers.byte( addr ) = value;
+            if ( _blockCache ) {
+                _blockCache->invalidate( addr );
+            }
         }
         else {
-            _bytes[ addr ] = value | 0xe0; // writing IE register bits
+            _registers.byte( addr ) = value | 0xe0; // writing IE register bits
+            updatePendingInterrupts();
         }
     }
 }
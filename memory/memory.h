@@ -2,6 +2,7 @@
 
 #include <cpu/registers.h>
 #include <memory/memoryRegion.h>
+#include <vector>
 
 namespace gbemu {
 
@@ -10,6 +11,10 @@ namespace gbemu {
     class PAPU;
     class VideoDisplay;
     class Timers;
+    class BlockCache;
+    class MemoryHook;
+    class CPUClock;
+    class CPU;
 
     class Memory : public WordIOProtocol< Memory >
     {
@@ -20,6 +25,10 @@ namespace gbemu {
         static const unsigned char kIFTimerOverflowFlag = 0x4;
         static const unsigned char kIFHighToLowFlag = 0x10;
 
+        // The address space is split in pages of 256 bytes.
+        static const int kPageSize = 256;
+        static const int kPageCount = 256;
+
         static bool isROMBank0( unsigned short addr );
         static bool isSwitchableROMBank( unsigned short addr );
         static bool isVideoRAM( unsigned short addr );
@@ -27,6 +36,7 @@ namespace gbemu {
         static bool isInternalRAM( unsigned short addr );
         static bool isInternalRAMEcho( unsigned short addr );
         static bool isOAM( unsigned short addr );
+        static bool isHighRAM( unsigned short addr );
         static bool isMemoryMapped( unsigned short addr );
         static unsigned short getSwitchableROMBankStart();
 
@@ -38,19 +48,67 @@ namespace gbemu {
         );
 
         void setKeyState( unsigned char state );
-        unsigned char readByte( unsigned short addr ) const;
-        void writeByte( unsigned short addr, unsigned char value );
+        JFX_INLINE unsigned char readByte( unsigned short addr ) const;
+        JFX_INLINE void writeByte( unsigned short addr, unsigned char value );
+        // A word inside a mapped page is accessed with a single load or
+        // store, the others byte by byte.
+        JFX_INLINE unsigned short readWord( unsigned short addr ) const;
+        JFX_INLINE void writeWord( unsigned short addr, unsigned short value );
+        // Copies count bytes starting at addr, in one go when they are all
+        // in a page that is mapped.
+        void readBytes( unsigned short addr, unsigned char* bytes, size_t count ) const;
         void loadCartridge( Cartridge& cartridge );
-        unsigned char& memoryRegister( unsigned short addr );
         bool hasBootRom() const;
+        bool isInBootRom( unsigned short addr ) const;
+        int getSwitchableROMBank() const;
+        void setBlockCache( BlockCache* blockCache );
+        // Writes to a page that holds code have to go through the block
+        // cache so it can drop the blocks they overwrite.
+        void setCodePage( int page, bool hasCode );
+
+        // Sends the accesses to the watched addresses to hook, timestamped
+        // with the clock and the instruction the cpu is executing. The
+        // instruction fetches and the DMA transfers are reported too.
+        void setHook( MemoryHook* hook, const CPUClock* clock, const CPU* cpu );
+        // Watches the reads and/or the writes from first to last included.
+        // Only the pages they overlap leave the direct access path.
+        void watch( unsigned short first, unsigned short last, bool reads, bool writes );
+        void clearWatches();
+
+        // While an OAM DMA transfer is running, the cpu can only access the
+        // registers and the high RAM. Other reads return 0xFF and other
+        // writes are dropped.
+        void setDMAActive( bool isActive );
+
+        // Interrupts that are both requested and enabled, IE & IF & 0x1F.
+        JFX_INLINE unsigned char getPendingInterrupts() const;
+        void requestInterrupt( unsigned char flag );
+        void acknowledgeInterrupt( unsigned char flag );
 
 
     private:
+        enum PageFlags { kCodePage = 0x1, kWatchReads = 0x2, kWatchWrites = 0x4 };
+
+        struct Watch
+        {
+            unsigned short first;
+            unsigned short last;
+            bool           reads;
+            bool           writes;
+        };
+
+        unsigned char readSlowByte( unsigned short addr ) const;
+        unsigned char readUnmappedByte( unsigned short addr ) const;
+        void writeSlowByte( unsigned short addr, unsigned char value );
+        void writeUnmappedByte( unsigned short addr, unsigned char value );
+        void recordAccess( unsigned short addr, unsigned char value, bool isWrite ) const;
+        void mapCartridgePages();
+        void mapPage( int page );
+        void updatePendingInterrupts();
+
         MemoryRegion< 0xC000, 0xE000 > _internalRAM;
-        // FIXME: This big array should be deprecated
-        // in favor of a smaller byte array that covers
-        // only the memory registers
-        unsigned char                  _bytes[64*1024];
+        // IO registers, high RAM and IE.
+        MemoryRegion< 0xFF00, 0x10000 > _registers;
         Cartridge*                     _cartridge;
         unsigned char                  _keyState;
         const BootRom&                 _bootRom;
@@ -58,5 +116,66 @@ namespace gbemu {
         mutable bool                   _isBooting;
         PAPU&                          _papu;
         Timers&                        _timers;
+        BlockCache*                    _blockCache;
+        unsigned char                  _pendingInterrupts;
+        bool                           _isDMAActive;
+        // Bytes of each page when they can be accessed directly, nullptr
+        // when the access has to go through the slow path.
+        const unsigned char*           _readPages[ kPageCount ];
+        unsigned char*                 _writePages[ kPageCount ];
+        unsigned char                  _pageFlags[ kPageCount ];
+        const unsigned char*           _romBank0;
+        const unsigned char*           _switchableROMBank;
+        const unsigned char*           _cartridgeRAMBank;
+        unsigned char*                 _videoRAM;
+        std::vector< Watch >           _watches;
+        MemoryHook*                    _hook;
+        const CPUClock*                _clock;
+        const CPU*                     _cpu;
     };
+
+    unsigned char Memory::readByte( const unsigned short addr ) const
+    {
+        const unsigned char* const page = _readPages[ addr >> 8 ];
+        if ( page != nullptr ) {
+            return page[ addr & 0xFF ];
+        }
+        return readSlowByte( addr );
+    }
+
+    void Memory::writeByte( const unsigned short addr, const unsigned char value )
+    {
+        unsigned char* const page = _writePages[ addr >> 8 ];
+        if ( page != nullptr ) {
+            page[ addr & 0xFF ] = value;
+        }
+        else {
+            writeSlowByte( addr, value );
+        }
+    }
+
+    unsigned short Memory::readWord( const unsigned short addr ) const
+    {
+        const unsigned char* const page = _readPages[ addr >> 8 ];
+        if ( page != nullptr && ( addr & 0xFF ) != 0xFF ) {
+            return loadLittleEndianWord( page + ( addr & 0xFF ) );
+        }
+        return WordIOProtocol< Memory >::readWord( addr );
+    }
+
+    void Memory::writeWord( const unsigned short addr, const unsigned short value )
+    {
+        unsigned char* const page = _writePages[ addr >> 8 ];
+        if ( page != nullptr && ( addr & 0xFF ) != 0xFF ) {
+            storeLittleEndianWord( page + ( addr & 0xFF ), value );
+        }
+        else {
+            WordIOProtocol< Memory >::writeWord( addr, value );
+        }
+    }
+
+    unsigned char Memory::getPendingInterrupts() const
+    {
+        return _pendingInterrupts;
+    }
 }
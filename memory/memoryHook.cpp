@@ -0,0 +1,21 @@
+#include <memory/memoryHook.h>
+
+namespace gbemu {
+
+    MemoryHook::MemoryHook( MemoryAccess* const buffer, const size_t capacity, Callback callback ) :
+        _buffer( buffer ),
+        _capacity( capacity ),
+        _count( 0 ),
+        _callback( std::move( callback ) )
+    {
+        JFX_CMP_ASSERT( capacity, >, size_t( 0 ) );
+    }
+
+    void MemoryHook::flush()
+    {
+        if ( _count != 0 ) {
+            _callback( _buffer, _count );
+            _count = 0;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <common/common.h>
+#include <cstdint>
+#include <functional>
+
+namespace gbemu {
+
+    // A read or a write to a watched address.
+    struct MemoryAccess
+    {
+        // Time of the instruction that made the access.
+        int64_t        cycle;
+        unsigned short pc;
+        unsigned short addr;
+        unsigned char  value;
+        bool           isWrite;
+    };
+
+    // Collects the accesses to the watched addresses in a buffer owned by the
+    // caller, and hands them over to the callback when it is full or flushed.
+    class MemoryHook
+    {
+    public:
+        typedef std::function< void( const MemoryAccess* accesses, size_t count ) > Callback;
+
+        MemoryHook( MemoryAccess* buffer, size_t capacity, Callback callback );
+
+        JFX_INLINE void record( const MemoryAccess& access );
+        void flush();
+
+    private:
+        MemoryAccess* _buffer;
+        size_t        _capacity;
+        size_t        _count;
+        Callback      _callback;
+    };
+
+    void MemoryHook::record( const MemoryAccess& access )
+    {
+        _buffer[ _count++ ] = access;
+        if ( _count == _capacity ) {
+            flush();
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#include <memory/ramWriter.h>
+#include <memory/cartridgeRAM.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifndef WINDOWS
+#include <unistd.h>
+#endif
+
+namespace gbemu {
+
+    RAMWriter::RAMWriter( const std::string& path, const CartridgeRAM& ram ) :
+        _path( path ),
+        _bytes( ram.getBytes(), ram.getBytes() + ram.getSize() ),
+        _pendingBytes( 0 ),
+        _isPending( false ),
+        _isStopping( false )
+    {
+        memset( &_stats, 0, sizeof( _stats ) );
+        _thread = std::thread( &RAMWriter::run, this );
+    }
+
+    RAMWriter::~RAMWriter()
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _isStopping = true;
+        }
+        _condition.notify_one();
+        _thread.join();
+    }
+
+    void RAMWriter::write( CartridgeRAM& ram )
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            for ( size_t page = 0; page < ram.getPageCount(); ++page ) {
+                if ( ram.isPageDirty( page ) ) {
+                    const size_t offset = page * CartridgeRAM::kPageSize;
+                    const size_t size = std::min( CartridgeRAM::kPageSize, ram.getSize() - offset );
+                    memcpy( &_bytes[ offset ], ram.getBytes() + offset, size );
+                    _pendingBytes += size;
+                }
+            }
+            _isPending = true;
+        }
+        ram.clearDirtyPages();
+        _condition.notify_one();
+    }
+
+    RAMWriter::Stats RAMWriter::getStats() const
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return _stats;
+    }
+
+    void RAMWriter::run()
+    {
+        std::vector< unsigned char > bytes;
+        std::unique_lock< std::mutex > lock( _mutex );
+        for ( ;; ) {
+            _condition.wait( lock, [this]() { return _isPending || _isStopping; } );
+            if ( !_isPending ) {
+                return;
+            }
+            bytes = _bytes;
+            const unsigned long long pendingBytes = _pendingBytes;
+            _pendingBytes = 0;
+            _isPending = false;
+
+            // The emulation can keep on dirtying pages while the file is
+            // written.
+            lock.unlock();
+            const std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+            const bool isSaved = save( bytes );
+            const unsigned long long latency = static_cast< unsigned long long >(
+                std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - start ).count()
+            );
+            lock.lock();
+
+            if ( isSaved ) {
+                ++_stats.flushes;
+                _stats.bytesFlushed += pendingBytes;
+                _stats.lastLatency = latency;
+                _stats.maxLatency = std::max( _stats.maxLatency, latency );
+                _stats.totalLatency += latency;
+            }
+            else {
+                ++_stats.failures;
+            }
+        }
+    }
+
+    bool RAMWriter::save( const std::vector< unsigned char >& bytes ) const
+    {
+        const std::string tempPath( _path + ".tmp" );
+        FILE* const file = fopen( tempPath.c_str(), "wb" );
+        if ( file == nullptr ) {
+            return false;
+        }
+        bool isWritten = fwrite( bytes.data(), 1, bytes.size(), file ) == bytes.size() && fflush( file ) == 0;
+#ifndef WINDOWS
+        // Make sure the bytes are on disk before the rename makes them the
+        // save.
+        isWritten = isWritten && fsync( fileno( file ) ) == 0;
+#endif
+        isWritten = fclose( file ) == 0 && isWritten;
+        if ( !isWritten ) {
+            remove( tempPath.c_str() );
+            return false;
+        }
+#ifdef WINDOWS
+        // rename doesn't replace an existing file on Windows.
+        remove( _path.c_str() );
+#endif
+        return rename( tempPath.c_str(), _path.c_str() ) == 0;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gbemu {
+
+    class CartridgeRAM;
+
+    // Saves the RAM of a cartridge from a thread of its own. The save is
+    // written to a temporary file that is then renamed over the previous one,
+    // so a crash never leaves a partial save behind.
+    class RAMWriter
+    {
+    public:
+        struct Stats
+        {
+            unsigned long long flushes;
+            unsigned long long failures;
+            // Bytes of the dirty pages that were saved.
+            unsigned long long bytesFlushed;
+            // Time taken to write and rename the files, in microseconds.
+            unsigned long long lastLatency;
+            unsigned long long maxLatency;
+            unsigned long long totalLatency;
+        };
+
+        RAMWriter( const std::string& path, const CartridgeRAM& ram );
+        // Waits for the last pages to be saved.
+        ~RAMWriter();
+
+        // Copies the dirty pages of the RAM for the thread to save and marks
+        // them clean.
+        void write( CartridgeRAM& ram );
+        Stats getStats() const;
+
+    private:
+        RAMWriter( const RAMWriter& ) = delete;
+        RAMWriter& operator=( const RAMWriter& ) = delete;
+
+        void run();
+        bool save( const std::vector< unsigned char >& bytes ) const;
+
+        const std::string            _path;
+        mutable std::mutex           _mutex;
+        std::condition_variable      _condition;
+        // Content of the file once the pending pages are saved.
+        std::vector< unsigned char > _bytes;
+        unsigned long long           _pendingBytes;
+        bool                         _isPending;
+        bool                         _isStopping;
+        Stats                        _stats;
+        std::thread                  _thread;
+    };
+}
@@ -0,0 +1,143 @@
+#include <memory/romImage.h>
+#include <common/common.h>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#ifndef WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    using namespace gbemu;
+
+    const size_t kROMBankSize = 16 * 1024;
+
+    unsigned long long hashBytes( const unsigned char* const bytes, const size_t size )
+    {
+        // FNV-1a
+        unsigned long long hash = 14695981039346656037ULL;
+        for ( size_t i = 0; i < size; ++i ) {
+            hash = ( hash ^ bytes[ i ] ) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // Images loaded by the process, by hash of their content. The images are
+    // owned by the cartridges, so an image no cartridge uses anymore is
+    // released.
+    typedef std::unordered_map< unsigned long long, std::weak_ptr< const ROMImage > > ImageCache;
+
+    std::mutex& getCacheMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    ImageCache& getCache()
+    {
+        static ImageCache cache;
+        return cache;
+    }
+}
+
+namespace gbemu {
+
+    ROMImage::ROMImage() :
+        _bytes( nullptr ),
+        _size( 0 ),
+        _mapping( nullptr ),
+        _mappingSize( 0 )
+    {}
+
+    ROMImage::~ROMImage()
+    {
+#ifndef WINDOWS
+        if ( _mapping != nullptr ) {
+            munmap( _mapping, _mappingSize );
+        }
+#endif
+    }
+
+    std::shared_ptr< const ROMImage > ROMImage::load( const std::string& filename )
+    {
+#ifdef WINDOWS
+        std::vector< unsigned char > bytes( readFile( filename ) );
+        if ( bytes.empty() ) {
+            return nullptr;
+        }
+        return create( std::move( bytes ) );
+#else
+        const int file = open( filename.c_str(), O_RDONLY );
+        if ( file < 0 ) {
+            return nullptr;
+        }
+        struct stat status;
+        void* mapping = MAP_FAILED;
+        if ( fstat( file, &status ) == 0 && status.st_size > 0 ) {
+            mapping = mmap( nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+        }
+        close( file );
+        if ( mapping == MAP_FAILED ) {
+            return nullptr;
+        }
+
+        std::unique_ptr< ROMImage > image( new ROMImage );
+        image->_mapping = mapping;
+        image->_mappingSize = (size_t)status.st_size;
+        // The pages past the end of the file can't be read, so an image that
+        // needs padding is copied.
+        if ( image->_mappingSize % kROMBankSize != 0 ) {
+            const unsigned char* const bytes = static_cast< const unsigned char* >( mapping );
+            return create( std::vector< unsigned char >( bytes, bytes + image->_mappingSize ) );
+        }
+        image->_bytes = static_cast< const unsigned char* >( mapping );
+        image->_size = image->_mappingSize;
+        return share( std::move( image ) );
+#endif
+    }
+
+    std::shared_ptr< const ROMImage > ROMImage::create( std::vector< unsigned char > bytes )
+    {
+        std::unique_ptr< ROMImage > image( new ROMImage );
+        image->_copy = std::move( bytes );
+        image->_copy.resize( ( image->_copy.size() + kROMBankSize - 1 ) & ~( kROMBankSize - 1 ), 0xFF );
+        image->_bytes = image->_copy.data();
+        image->_size = image->_copy.size();
+        return share( std::move( image ) );
+    }
+
+    std::shared_ptr< const ROMImage > ROMImage::share( std::unique_ptr< ROMImage > image )
+    {
+        JFX_CMP_ASSERT( image->_size, <=, kMaxSize );
+        const unsigned long long hash = hashBytes( image->_bytes, image->_size );
+
+        std::lock_guard< std::mutex > lock( getCacheMutex() );
+        ImageCache& cache( getCache() );
+        std::weak_ptr< const ROMImage >& entry( cache[ hash ] );
+        std::shared_ptr< const ROMImage > shared( entry.lock() );
+        if ( shared &&
+             shared->_size == image->_size &&
+             memcmp( shared->_bytes, image->_bytes, image->_size ) == 0 )
+        {
+            return shared;
+        }
+        shared.reset( image.release() );
+        entry = shared;
+        return shared;
+    }
+
+    const unsigned char* ROMImage::getBytes() const
+    {
+        return _bytes;
+    }
+
+    size_t ROMImage::getSize() const
+    {
+        return _size;
+    }
+}
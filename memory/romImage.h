@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gbemu {
+
+    // Read-only bytes of a cartridge ROM. Every cartridge that loads the same
+    // bytes, from the same file or not, shares a single image.
+    class ROMImage
+    {
+    public:
+        static const size_t kMaxSize = 8 * 1024 * 1024;
+
+        // Maps the file in memory, or returns nullptr if it can't be read.
+        static std::shared_ptr< const ROMImage > load( const std::string& filename );
+        static std::shared_ptr< const ROMImage > create( std::vector< unsigned char > bytes );
+
+        ~ROMImage();
+
+        const unsigned char* getBytes() const;
+        // Always a multiple of the 16k of a ROM bank, images that are not are
+        // padded with 0xFF.
+        size_t getSize() const;
+
+    private:
+        ROMImage();
+        ROMImage( const ROMImage& ) = delete;
+        ROMImage& operator=( const ROMImage& ) = delete;
+
+        static std::shared_ptr< const ROMImage > share( std::unique_ptr< ROMImage > image );
+
+        const unsigned char*         _bytes;
+        size_t                       _size;
+        // The file mapping, or the copy of the bytes if they couldn't be
+        // mapped as is.
+        void*                        _mapping;
+        size_t                       _mappingSize;
+        std::vector< unsigned char > _copy;
+    };
+}
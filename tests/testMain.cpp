@@ -1,6 +1,12 @@
 #include <base/cyclicCounter.imp.h>
 #include <base/clock.imp.h>
 #include <common/common.h>
+#include <cpu/profiler.h>
+#include <memory/romImage.h>
+#include <memory/mbc.h>
+#include <memory/cartridgeRAM.h>
+#include <video/scanline.h>
+#include <sstream>
 
 using namespace gbemu;
 
@@ -46,12 +52,140 @@ void testClockT()
         JFX_ASSERT(!_512hzClock.increment());
     }
     JFX_ASSERT(_512hzClock.increment());
+
+    ClockT<8, 7> a8(0);
+    JFX_CMP_ASSERT(a8.getCyclesToNextTick(), ==, 7);
+    JFX_ASSERT(!a8.advance(6));
+    JFX_CMP_ASSERT(a8.getCyclesToNextTick(), ==, 1);
+    JFX_ASSERT(a8.advance(1));
+    JFX_CMP_ASSERT(a8.getCyclesToNextTick(), ==, 8);
+    JFX_ASSERT(a8.advance(8));
+}
+
+void testProfiler()
+{
+    Profiler profiler;
+    profiler.record(0, 0x0150, kNop, 4);
+    profiler.record(0, 0x0150, kNop, 4);
+    profiler.record(2, 0x4000, CALL_nn, 12);
+    profiler.record(1, 0x4000, BIT_7_H, 8);
+    JFX_CMP_ASSERT(profiler.getTotalCycles(), ==, 28ull);
+
+    std::ostringstream json;
+    profiler.writeJSON(json, 2);
+    const std::string report(json.str());
+    // Addresses are sorted by cycles and the same pc in another bank is
+    // counted separately.
+    JFX_ASSERT(report.find("\"bank\": 2, \"pc\": 16384") < report.find("\"bank\": 0, \"pc\": 336"));
+    JFX_ASSERT(report.find("\"bank\": 1") == std::string::npos);
+    JFX_ASSERT(report.find("\"name\": \"CALL_nn\"") < report.find("\"name\": \"kNop\""));
+
+    profiler.reset();
+    JFX_CMP_ASSERT(profiler.getTotalCycles(), ==, 0ull);
+}
+
+void testOpcodeTable()
+{
+    static_assert(getOpcodeInfo(LD_BC_nn).length == 3, "LD BC,nn has a word operand");
+    static_assert(getOpcodeInfo(JR_NZ_n).takenCycles > getOpcodeInfo(JR_NZ_n).cycles, "taken jumps take longer");
+    static_assert(getOpcodeInfo(BIT_7_H).length == 2, "CB opcodes are two bytes long");
+    JFX_CMP_ASSERT(int(getOpcodeInfo(ACD_A_MPC).flagsRead), ==, 0x10);
+    JFX_CMP_ASSERT(int(getOpcodeInfo(INC_B).flagsWritten), ==, 0xE0);
+    JFX_ASSERT(!getOpcodeInfo(static_cast<Opcode>(0xD3)).isDefined);
+
+    const unsigned char ld[] = { 0x01, 0x34, 0x12 };
+    JFX_CMP_ASSERT(disassemble(0x0150, ld), ==, std::string("LD BC,$1234"));
+    const unsigned char jr[] = { 0x20, 0xFE };
+    JFX_CMP_ASSERT(disassemble(0x0150, jr), ==, std::string("JR NZ,$0150"));
+    const unsigned char addSP[] = { 0xE8, 0xFC };
+    JFX_CMP_ASSERT(disassemble(0x0150, addSP), ==, std::string("ADD SP,-4"));
+    const unsigned char bit[] = { 0xCB, 0x7C };
+    JFX_CMP_ASSERT(disassemble(0x0150, bit), ==, std::string("BIT 7,H"));
+}
+
+void testROMImage()
+{
+    const std::vector<unsigned char> bytes(0x5000, 0x12);
+    const std::shared_ptr<const ROMImage> image(ROMImage::create(bytes));
+    // Padded to whole banks.
+    JFX_CMP_ASSERT(image->getSize(), ==, size_t(0x8000));
+    JFX_CMP_ASSERT(int(image->getBytes()[0x4FFF]), ==, 0x12);
+    JFX_CMP_ASSERT(int(image->getBytes()[0x5000]), ==, 0xFF);
+
+    // The same bytes share an image, other bytes don't.
+    JFX_ASSERT(ROMImage::create(bytes) == image);
+    JFX_ASSERT(ROMImage::create(std::vector<unsigned char>(0x5000, 0x34)) != image);
+}
+
+void testMBC5()
+{
+    // Each bank starts with its index.
+    std::vector<unsigned char> bytes(512 * 0x4000);
+    for (size_t bank = 0; bank < 512; ++bank) {
+        bytes[bank * 0x4000] = static_cast<unsigned char>(bank);
+        bytes[bank * 0x4000 + 1] = static_cast<unsigned char>(bank >> 8);
+    }
+    const std::shared_ptr<const ROMImage> image(ROMImage::create(bytes));
+    CartridgeRAM ram;
+    ram.assign(std::vector<unsigned char>(4 * 0x2000, 0));
+    std::unique_ptr<MemoryBlockController> mbc(MemoryBlockController::create(Cartridge::kROM_MBC5_RAM_BATT, *image, ram));
+
+    // The 9th bit of the ROM bank is written separately, and bank 0 can be
+    // mapped twice.
+    mbc->writeByte(0x2000, 0x23);
+    mbc->writeByte(0x3000, 0x01);
+    JFX_CMP_ASSERT(mbc->getSwitchableROMBank(), ==, 0x123);
+    JFX_CMP_ASSERT(int(mbc->readByte(0x4000)), ==, 0x23);
+    JFX_CMP_ASSERT(int(mbc->readByte(0x4001)), ==, 0x01);
+    mbc->writeByte(0x3000, 0x00);
+    mbc->writeByte(0x2000, 0x00);
+    JFX_CMP_ASSERT(mbc->getSwitchableROMBank(), ==, 0);
+
+    // The RAM is only mapped once enabled.
+    mbc->writeByte(0xA000, 0x56);
+    JFX_ASSERT(mbc->getRAMBankBytes() == nullptr);
+    mbc->writeByte(0x0000, 0x0A);
+    mbc->writeByte(0x4000, 0x02);
+    mbc->writeByte(0xA001, 0x56);
+    JFX_CMP_ASSERT(int(ram.getBytes()[2 * 0x2000 + 1]), ==, 0x56);
+    JFX_CMP_ASSERT(int(mbc->readByte(0xA001)), ==, 0x56);
+    JFX_ASSERT(ram.isPageDirty((2 * 0x2000 + 1) / CartridgeRAM::kPageSize));
 }
 
+void testScanline()
+{
+    for (int low = 0; low < 256; ++low) {
+        for (int high = 0; high < 256; ++high) {
+            unsigned char indices[8];
+            scanline::decodeTileRow(static_cast<unsigned char>(low), static_cast<unsigned char>(high), indices);
+            for (int x = 0; x < 8; ++x) {
+                JFX_CMP_ASSERT(int(indices[x]), ==, ((low >> (7 - x)) & 1) | (((high >> (7 - x)) & 1) << 1));
+            }
+        }
+    }
+
+    // Not a multiple of the vector size, so the scalar tail is covered too.
+    unsigned char indices[37];
+    for (size_t i = 0; i < sizeof(indices); ++i) {
+        indices[i] = static_cast<unsigned char>((i * 7) & 0x3);
+    }
+    for (int palette = 0; palette < 256; ++palette) {
+        unsigned char shades[sizeof(indices)];
+        unsigned char expected[sizeof(indices)];
+        scanline::applyPalette(indices, shades, sizeof(indices), static_cast<unsigned char>(palette));
+        scanline::applyPaletteScalar(indices, expected, sizeof(indices), static_cast<unsigned char>(palette));
+        JFX_ASSERT(memcmp(shades, expected, sizeof(shades)) == 0);
+    }
+}
 
 int main(const int argc, char const * const* const argv)
 {
     testClockT();
+    testProfiler();
+    testOpcodeTable();
+    testROMImage();
+    testMBC5();
+    testScanline();
 
     return 0;
 }
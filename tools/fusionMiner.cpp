@@ -0,0 +1,158 @@
+// Runs a ROM with the profiler and lists the sequences of instructions that
+// are executed the most, as candidates for the fused handlers of the CPU.
+//
+// usage: fusionMiner rom [frames] [maxLength] [topCount]
+
+#include <gbemu.h>
+#include <cpu/blockCache.h>
+#include <cpu/profiler.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef GBEMU_PROFILER
+#error "fusionMiner needs the profiler, build with GBEMU_PROFILER."
+#endif
+
+using namespace gbemu;
+
+namespace {
+
+    const int kCyclesPerFrame = 70224;
+
+    struct Sequence
+    {
+        unsigned long long executions;
+        unsigned long long cycles;
+        size_t             length;
+    };
+
+    typedef std::map< std::vector< unsigned int >, Sequence > SequenceMap;
+    // Number of dispatches fusing a sequence would save.
+    typedef std::pair< unsigned long long, SequenceMap::const_iterator > Candidate;
+
+    bool savesMoreDispatches( const Candidate& left, const Candidate& right )
+    {
+        return left.first > right.first;
+    }
+
+    // Offset in the ROM file of an address of a ROM bank, or -1.
+    long getROMOffset( const unsigned int bank, const unsigned int pc )
+    {
+        if ( pc < 0x4000 ) {
+            return pc;
+        }
+        if ( pc < 0x8000 ) {
+            return static_cast< long >( bank ) * 0x4000 + pc - 0x4000;
+        }
+        return -1;
+    }
+
+    // Opcode of the instruction at offset, 0xCBxx for the CB opcodes.
+    unsigned int readOpcode( const std::vector< unsigned char >& rom, const long offset )
+    {
+        return rom[ offset ] == 0xCB ? 0xCB00 | rom[ offset + 1 ] : rom[ offset ];
+    }
+
+    std::string getSequenceName( const std::vector< unsigned int >& opcodes )
+    {
+        std::string name;
+        for ( size_t i = 0; i < opcodes.size(); ++i ) {
+            name += ( i == 0 ? "" : " / " );
+            name += getOpcodeName( opcodes[ i ] );
+        }
+        return name;
+    }
+}
+
+int main( const int argc, char const * const* const argv )
+{
+    if ( argc < 2 ) {
+        std::cout << "usage: " << argv[ 0 ] << " rom [frames] [maxLength] [topCount]" << std::endl;
+        return 1;
+    }
+    const int nbFrames = argc > 2 ? atoi( argv[ 2 ] ) : 3600;
+    const size_t maxLength = argc > 3 ? atoi( argv[ 3 ] ) : 4;
+    const size_t topCount = argc > 4 ? atoi( argv[ 4 ] ) : 30;
+
+    std::ifstream file( argv[ 1 ], std::ios::binary );
+    const std::vector< unsigned char > rom( ( std::istreambuf_iterator< char >( file ) ), std::istreambuf_iterator< char >() );
+
+    std::unique_ptr< Gameboy > gb( initGlobalEmulatorParams( argv[ 1 ], nullptr ) );
+    for ( int i = 0; i < nbFrames; ++i ) {
+        emulateSomeCycles( *gb, kCyclesPerFrame );
+    }
+
+    const Profiler& profiler( gb->getCPU().getProfiler() );
+    const std::vector< Profiler::Entry > addresses( profiler.getTopAddresses( std::numeric_limits< size_t >::max() ) );
+    std::unordered_map< unsigned int, const Profiler::Entry* > entries;
+    for ( size_t i = 0; i < addresses.size(); ++i ) {
+        entries[ addresses[ i ].key ] = &addresses[ i ];
+    }
+
+    // A straight-line sequence runs at most as many times as its least
+    // executed instruction.
+    SequenceMap sequences;
+    for ( size_t i = 0; i < addresses.size(); ++i ) {
+        const unsigned int bank = addresses[ i ].key >> 16;
+        unsigned int pc = addresses[ i ].key & 0xFFFF;
+        std::vector< unsigned int > opcodes;
+        unsigned long long executions = std::numeric_limits< unsigned long long >::max();
+        unsigned long long cycles = 0;
+        while ( opcodes.size() < maxLength ) {
+            const long offset = getROMOffset( bank, pc );
+            std::unordered_map< unsigned int, const Profiler::Entry* >::const_iterator it = entries.find( bank << 16 | pc );
+            if ( offset < 0 || offset + 1 >= static_cast< long >( rom.size() ) || it == entries.end() ) {
+                break;
+            }
+            const unsigned int opcode = readOpcode( rom, offset );
+            const int length = getInstructionLength( rom[ offset ] );
+            // Sequences can't cross from one bank to the other.
+            if ( ( pc < 0x4000 ) != ( pc + length - 1 < 0x4000 ) ) {
+                break;
+            }
+            opcodes.push_back( opcode );
+            executions = std::min( executions, it->second->executions );
+            cycles += it->second->cycles / it->second->executions;
+            if ( opcodes.size() > 1 ) {
+                Sequence& sequence( sequences[ opcodes ] );
+                sequence.executions += executions;
+                sequence.cycles += executions * cycles;
+                sequence.length = opcodes.size();
+            }
+            // Only the last instruction of a sequence can jump.
+            if ( opcode < 0x100 && endsBlock( static_cast< unsigned char >( opcode ) ) ) {
+                break;
+            }
+            pc += length;
+        }
+    }
+
+    // Each fused sequence saves the dispatch of all but its first
+    // instruction.
+    std::vector< Candidate > ranking;
+    for ( SequenceMap::const_iterator it = sequences.begin(); it != sequences.end(); ++it ) {
+        ranking.push_back( Candidate( it->second.executions * ( it->second.length - 1 ), it ) );
+    }
+    const size_t count = std::min( topCount, ranking.size() );
+    std::partial_sort( ranking.begin(), ranking.begin() + count, ranking.end(), savesMoreDispatches );
+
+    std::cout << "Total cycles: " << profiler.getTotalCycles() << std::endl << std::endl;
+    std::cout << std::setw( 14 ) << "dispatches" << std::setw( 14 ) << "executions" << std::setw( 14 ) << "cycles" << "  sequence" << std::endl;
+    for ( size_t i = 0; i < count; ++i ) {
+        const Sequence& sequence( ranking[ i ].second->second );
+        std::cout << std::setw( 14 ) << ranking[ i ].first
+                  << std::setw( 14 ) << sequence.executions
+                  << std::setw( 14 ) << sequence.cycles
+                  << "  " << getSequenceName( ranking[ i ].second->first ) << std::endl;
+    }
+    return 0;
+}
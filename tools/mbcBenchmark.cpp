@@ -0,0 +1,112 @@
+// Measures the cost of reading the ROM through a memory block controller,
+// compared to resolving the bank on every read as MBC1 used to do.
+//
+// usage: mbcBenchmark [reads]
+
+#include <memory/mbc.h>
+#include <memory/romImage.h>
+#include <memory/cartridgeRAM.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace gbemu;
+
+namespace {
+
+    const int kROMSize = 1024 * 1024;
+    // Reads between two switches of the ROM bank.
+    const int kReadsPerBankSwitch = 4096;
+
+    // Reference implementation, the bank is looked up, the address bounds
+    // checked and wrapped around the size of the ROM on every read, behind
+    // a virtual call as the controllers used to be.
+    class ROMReader
+    {
+    public:
+        virtual ~ROMReader() {}
+        virtual void writeByte( unsigned short addr, unsigned char value ) = 0;
+        virtual unsigned char readByte( unsigned short addr ) const = 0;
+    };
+
+    class LegacyMBC : public ROMReader
+    {
+    public:
+        LegacyMBC( const std::vector< unsigned char >& rom ) :
+            _rom( rom ),
+            _romRamBits( 0 ),
+            _lowerRomBankBits( 0 )
+        {}
+
+        void writeByte( const unsigned short addr, const unsigned char value )
+        {
+            if ( addr >= 0x2000 && addr < 0x4000 ) {
+                _lowerRomBankBits = value & 0x1F;
+            }
+        }
+        unsigned char readByte( const unsigned short addr ) const
+        {
+            if ( addr < 0x4000 ) {
+                return _rom.at( (size_t)( addr % (int)_rom.size() ) );
+            }
+            const int index = ( ( ( _romRamBits << 5 ) | _lowerRomBankBits ) * 16 * 1024 ) | ( addr - 0x4000 );
+            return _rom.at( (size_t)( index % (int)_rom.size() ) );
+        }
+    private:
+        const std::vector< unsigned char >& _rom;
+        int _romRamBits;
+        int _lowerRomBankBits;
+    };
+
+    // Walks the ROM window, switching banks now and then, and returns the
+    // nanoseconds per read. Like the CPU fetching instructions, each address
+    // depends on the byte read before it.
+    template< typename MBC >
+    double measure( MBC& mbc, const int nbReads, unsigned int& checksum )
+    {
+        const std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+        unsigned short addr = 0;
+        for ( int i = 0; i < nbReads; ++i ) {
+            if ( i % kReadsPerBankSwitch == 0 ) {
+                mbc.writeByte( 0x2000, static_cast< unsigned char >( 1 + ( i / kReadsPerBankSwitch ) % 31 ) );
+            }
+            const unsigned char value = mbc.readByte( addr );
+            checksum += value;
+            addr = ( addr + 1 + ( value & 0x3 ) ) & 0x7FFF;
+        }
+        const std::chrono::duration< double, std::nano > elapsed( std::chrono::steady_clock::now() - start );
+        return elapsed.count() / nbReads;
+    }
+}
+
+int main( const int argc, char const * const* const argv )
+{
+    const int nbReads = argc > 1 ? atoi( argv[ 1 ] ) : 100000000;
+
+    std::vector< unsigned char > rom( kROMSize );
+    for ( size_t i = 0; i < rom.size(); ++i ) {
+        rom[ i ] = static_cast< unsigned char >( i * 31 + ( i >> 14 ) );
+    }
+    CartridgeRAM ram;
+
+    LegacyMBC legacyMBC( rom );
+    ROMReader& legacy( legacyMBC );
+    const std::shared_ptr< const ROMImage > image( ROMImage::create( rom ) );
+    std::unique_ptr< MemoryBlockController > mbc( MemoryBlockController::create( Cartridge::kROM_MBC1, *image, ram ) );
+
+    unsigned int legacyChecksum = 0;
+    const double legacyTime = measure( legacy, nbReads, legacyChecksum );
+    unsigned int mbcChecksum = 0;
+    const double mbcTime = measure( *mbc, nbReads, mbcChecksum );
+
+    if ( legacyChecksum != mbcChecksum ) {
+        std::cout << "The two controllers didn't read the same bytes." << std::endl;
+        return 1;
+    }
+    std::cout << std::fixed << std::setprecision( 2 )
+              << "bank resolved on every read: " << legacyTime << " ns/read" << std::endl
+              << "inline cached bank pointers: " << mbcTime << " ns/read" << std::endl;
+    return 0;
+}
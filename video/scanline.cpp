@@ -0,0 +1,110 @@
+#include <video/scanline.h>
+#include <cstdint>
+#include <cstring>
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define GBEMU_HAS_SSSE3_KERNELS
+#include <tmmintrin.h>
+#endif
+
+namespace {
+
+    using namespace gbemu;
+
+    // Each bit of a byte spread to a byte of its own, the most significant
+    // bit first like the pixels of a tile row.
+    struct SpreadTable
+    {
+        SpreadTable()
+        {
+            for ( int value = 0; value < 256; ++value ) {
+                for ( int x = 0; x < 8; ++x ) {
+                    bytes[ value ][ x ] = static_cast< unsigned char >( ( value >> ( 7 - x ) ) & 0x1 );
+                }
+            }
+        }
+
+        unsigned char bytes[ 256 ][ 8 ];
+    };
+
+    const SpreadTable kSpreadTable;
+
+    typedef void ( *PaletteKernel )( const unsigned char*, unsigned char*, size_t, unsigned char );
+
+#ifdef GBEMU_HAS_SSSE3_KERNELS
+    // The palette goes in the first 4 bytes of a register and a byte shuffle
+    // looks up 16 indices at once.
+    __attribute__(( target( "ssse3" ) ))
+    void applyPaletteSSSE3(
+        const unsigned char* const indices,
+        unsigned char* const       shades,
+        const size_t               count,
+        const unsigned char        palette
+    )
+    {
+        const __m128i table = _mm_setr_epi8(
+            palette & 0x3, ( palette >> 2 ) & 0x3, ( palette >> 4 ) & 0x3, ( palette >> 6 ) & 0x3,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+        );
+        size_t i = 0;
+        for ( ; i + 16 <= count; i += 16 ) {
+            const __m128i chunk = _mm_loadu_si128( reinterpret_cast< const __m128i* >( indices + i ) );
+            _mm_storeu_si128( reinterpret_cast< __m128i* >( shades + i ), _mm_shuffle_epi8( table, chunk ) );
+        }
+        scanline::applyPaletteScalar( indices + i, shades + i, count - i, palette );
+    }
+#endif
+
+    PaletteKernel selectPaletteKernel()
+    {
+#ifdef GBEMU_HAS_SSSE3_KERNELS
+        // This runs before main, where the features haven't been read yet.
+        __builtin_cpu_init();
+        if ( __builtin_cpu_supports( "ssse3" ) ) {
+            return applyPaletteSSSE3;
+        }
+#endif
+        return scanline::applyPaletteScalar;
+    }
+
+    const PaletteKernel kPaletteKernel = selectPaletteKernel();
+}
+
+namespace gbemu {
+    namespace scanline {
+
+        void decodeTileRow( const unsigned char low, const unsigned char high, unsigned char* const indices )
+        {
+            // The bits of the two planes never carry into the next byte, so
+            // the 8 pixels are combined in one go.
+            uint64_t lowBits;
+            uint64_t highBits;
+            memcpy( &lowBits, kSpreadTable.bytes[ low ], sizeof( lowBits ) );
+            memcpy( &highBits, kSpreadTable.bytes[ high ], sizeof( highBits ) );
+            const uint64_t pixels = lowBits | ( highBits << 1 );
+            memcpy( indices, &pixels, sizeof( pixels ) );
+        }
+
+        void applyPalette(
+            const unsigned char* const indices,
+            unsigned char* const       shades,
+            const size_t               count,
+            const unsigned char        palette
+        )
+        {
+            kPaletteKernel( indices, shades, count, palette );
+        }
+
+        void applyPaletteScalar(
+            const unsigned char* const indices,
+            unsigned char* const       shades,
+            const size_t               count,
+            const unsigned char        palette
+        )
+        {
+            for ( size_t i = 0; i < count; ++i ) {
+                shades[ i ] = ( palette >> ( indices[ i ] * 2 ) ) & 0x3;
+            }
+        }
+    }
+}
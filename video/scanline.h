@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace gbemu {
+
+    // Kernels the video display draws its lines with. They work on color
+    // indices and shades, one byte per pixel.
+    namespace scanline {
+
+        // Expands a row of a tile, given as its low and high bit planes, to
+        // the color indices of its 8 pixels, leftmost first.
+        void decodeTileRow( unsigned char low, unsigned char high, unsigned char* indices );
+
+        // Maps count color indices to their shade through an encoded palette,
+        // BGP, OBP0 or OBP1. Uses SSSE3 when the cpu has it.
+        void applyPalette( const unsigned char* indices, unsigned char* shades, size_t count, unsigned char palette );
+        void applyPaletteScalar( const unsigned char* indices, unsigned char* shades, size_t count, unsigned char palette );
+    }
+}
@@ -1,20 +1,82 @@
 #include <video/videoDisplay.h>
+#include <video/scanline.h>
 #include <memory/memory.h>
 #include <cpu/cpu.h>
 #include <array>
+#include <cstdint>
 
 namespace gbemu {
 
+    namespace {
+        // The RGB components of the four shades, from the lightest.
+        const unsigned char kShades[ 4 ][ 3 ] = {
+            { 252, 232, 160 },
+            { 220, 180, 92 },
+            { 152, 124, 60 },
+            { 76, 60, 28 }
+        };
+
+        // The size of the pixels is known at compile time so their copies
+        // are single stores.
+        template< int BytesPerPixel >
+        void storePixels(
+            unsigned char* const       pixels,
+            const unsigned char* const shades,
+            const unsigned char        shadePixels[ 4 ][ 4 ]
+        )
+        {
+            for ( int x = 0; x < 160; ++x ) {
+                memcpy( pixels + x * BytesPerPixel, shadePixels[ shades[ x ] ], BytesPerPixel );
+            }
+        }
+    }
+
     VideoDisplay::VideoDisplay(
         Memory& memory,
-        bool isInitialized
+        bool isInitialized,
+        PixelFormat pixelFormat
     ) : _memory( memory ),
         _lcdCycle( 0 ),
         _isFrameReady( false ),
+        _dmaCycles( 0 ),
+        _areSpritesSorted( false ),
         _scx( 0 ),
-        _scy( 0 )
+        _scy( 0 ),
+        _pixelFormat( pixelFormat ),
+        _bytesPerPixel( getBytesPerPixel( pixelFormat ) )
     {
         memset( _pixels, 0, sizeof( _pixels ) );
+        memset( _shadePixels, 0, sizeof( _shadePixels ) );
+        for ( int shade = 0; shade < 4; ++shade ) {
+            const unsigned char* const rgb = kShades[ shade ];
+            unsigned char* const bytes = _shadePixels[ shade ];
+            switch ( pixelFormat ) {
+                case PixelFormat::ShadeIndex:
+                    bytes[ 0 ] = static_cast< unsigned char >( shade );
+                    break;
+                case PixelFormat::RGB565: {
+                    const uint16_t pixel = static_cast< uint16_t >( ( rgb[ 0 ] >> 3 ) << 11 | ( rgb[ 1 ] >> 2 ) << 5 | rgb[ 2 ] >> 3 );
+                    memcpy( bytes, &pixel, sizeof( pixel ) );
+                    break;
+                }
+                case PixelFormat::RGB888:
+                case PixelFormat::RGBA8888:
+                    bytes[ 0 ] = rgb[ 0 ];
+                    bytes[ 1 ] = rgb[ 1 ];
+                    bytes[ 2 ] = rgb[ 2 ];
+                    bytes[ 3 ] = 0xFF;
+                    break;
+                case PixelFormat::BGRA8888:
+                    bytes[ 0 ] = rgb[ 2 ];
+                    bytes[ 1 ] = rgb[ 1 ];
+                    bytes[ 2 ] = rgb[ 0 ];
+                    bytes[ 3 ] = 0xFF;
+                    break;
+            }
+        }
+        // Nothing is decoded yet.
+        std::fill( _dirtyTiles, _dirtyTiles + kTileCount, true );
+        _hasDirtyTiles = true;
         if (isInitialized) {
             _lcdc = 0x91;
             _scy = 0x00;
@@ -42,22 +104,6 @@ namespace gbemu {
         return isVideoRAM( addr ) || isOAM( addr ) || isBetween( addr, kLCDC, kWX + 1 );
     }
 
-    Color shades[ 4 ] = { Color( 252,  232,  160 ),
-                          Color( 220, 180, 92 ),
-                          Color( 152, 124, 60 ),
-                          Color( 76,  60,  28 ) };
-
-    void decodePalette(
-        std::array< Color, 4 >& colors,
-        const unsigned char     encodedPalette
-    )
-    {
-        colors[ 0 ] = shades[ encodedPalette & 0x3 ];
-        colors[ 1 ] = shades[ ( encodedPalette >> 2 ) & 0x3 ];
-        colors[ 2 ] = shades[ ( encodedPalette >> 4 ) & 0x3 ];
-        colors[ 3 ] = shades[ ( encodedPalette >> 6 ) & 0x3 ];
-    }
-
     void VideoDisplay::drawTiles(
       const int                     scx,
       const int                     scy,
@@ -65,17 +111,16 @@ namespace gbemu {
       const unsigned short          tileMapStart,
       const bool                    dataSelect,
       const unsigned short          tileTableStart,
-      const std::array< Color, 4 >& bgPalette,
       const unsigned char           offsetX,
       const unsigned char           offsetY
     )
     {
         const unsigned char backgroundLine = static_cast< unsigned char >( scy + y - offsetY );
         const unsigned char tileLine = backgroundLine % 8;
-        // For every pixel on the scanline
+        // For every tile on the scanline
         for ( unsigned char x = offsetX; x < 160; ) {
             // Which pixel from the background are we diplaying now?
-            unsigned char backgroundPixel = static_cast< unsigned char >( scx + x - offsetX );
+            const unsigned char backgroundPixel = static_cast< unsigned char >( scx + x - offsetX );
 
             // Find out which tile this pixel falls into
             const unsigned short tileMapSlotAddr = tileMapStart + ( 32 * ( backgroundLine / 8 ) ) + ( backgroundPixel / 8 );
@@ -84,44 +129,83 @@ namespace gbemu {
             // Read the tile index from the tile map
             int tileIndex;
             if ( dataSelect ) {
-                tileIndex = _memory.readByte( tileMapSlotAddr );
+                tileIndex = readVideoRAMByte( tileMapSlotAddr );
             }
             else {
-                tileIndex = static_cast< char >( _memory.readByte( tileMapSlotAddr ) );
+                tileIndex = static_cast< char >( readVideoRAMByte( tileMapSlotAddr ) );
             }
 
             // Compute the location of the tile
             const unsigned short tileAddr = (unsigned short)(tileTableStart + ( tileIndex * 16 ));
-            // Get the pointer to the bytes of that tile
-            const unsigned short tileLineBytes( _memory.readWord( tileAddr + tileLine * 2 ) );
+            // Get the color indices of that tile's line
+            const unsigned char* const tileRow = getTileRow( tileAddr, tileLine, false );
 
             // The last tile that wants to be drawn has to be clipped to the border of the screen, hence the
-            // std::min.
+            // std::min. Only the first one doesn't start on a tile boundary.
             const int pixelsToDraw = std::min(8 - ( backgroundPixel % 8 ), 160 - x);
-            for ( int i = 0; i < pixelsToDraw; ++x, ++i, ++backgroundPixel ) {
-               unsigned char colorIndex = static_cast< unsigned char >(
-                  getBit( ( tileLineBytes & 0xFF ), 7 - ( backgroundPixel % 8 ) ) +
-                  ( getBit( ( tileLineBytes & 0xFF00 ) >> 8, 7 - ( backgroundPixel % 8 ) ) << 1 ) );
+            memcpy( &_lineIndices[ x ], tileRow + backgroundPixel % 8, pixelsToDraw );
+            x = static_cast< unsigned char >( x + pixelsToDraw );
+        }
+    }
 
-               getPixel(x, y) = bgPalette[ colorIndex ];
+    void VideoDisplay::decodeDirtyTiles()
+    {
+        for ( int tile = 0; tile < kTileCount; ++tile ) {
+            if ( !_dirtyTiles[ tile ] ) {
+                continue;
+            }
+            const unsigned char* const bytes = &_videoRam[ tile * 16 ];
+            for ( int row = 0; row < 8; ++row ) {
+                unsigned char* const indices = _tiles[ tile ][ row ];
+                scanline::decodeTileRow( bytes[ row * 2 ], bytes[ row * 2 + 1 ], indices );
+                for ( int x = 0; x < 8; ++x ) {
+                    _flippedTiles[ tile ][ row ][ 7 - x ] = indices[ x ];
+                }
             }
+            _dirtyTiles[ tile ] = false;
         }
+        _hasDirtyTiles = false;
     }
 
-    Color& VideoDisplay::getPixel( int x, int y ) {
-        // Make sure we are accessing a real pixel.
-        JFX_CMP_ASSERT( y, >=, 0 );
-        JFX_CMP_ASSERT( y, <, 144 );
-        JFX_CMP_ASSERT( x, >=, 0 );
-        JFX_CMP_ASSERT( x, <, 160 );
-
-        return _pixels[ y ][ x ];
+    void VideoDisplay::sortSprites()
+    {
+        const int spriteHeight = getBit( _lcdc, 2 ) ? 16 : 8;
+        memset( _lineSpriteCounts, 0, sizeof( _lineSpriteCounts ) );
+        // The first sprites of the OAM that sit on a line are the ones
+        // displayed on it, wherever they are on the X axis.
+        for ( int sprite = 0; sprite < kSpriteCount; ++sprite ) {
+            const int top = _oamRegion[ sprite * 4 ] - 16;
+            const int bottom = std::min( top + spriteHeight, 144 );
+            for ( int y = std::max( top, 0 ); y < bottom; ++y ) {
+                if ( _lineSpriteCounts[ y ] < kMaxSpritesPerLine ) {
+                    _lineSprites[ y ][ _lineSpriteCounts[ y ]++ ] = static_cast< unsigned char >( sprite );
+                }
+            }
+        }
+        // Then the leftmost sprite has the priority, or the first one in the
+        // OAM when they are at the same X. The sort is stable, so the OAM
+        // order breaks the ties.
+        for ( int y = 0; y < 144; ++y ) {
+            unsigned char* const sprites = _lineSprites[ y ];
+            for ( int i = 1; i < _lineSpriteCounts[ y ]; ++i ) {
+                const unsigned char sprite = sprites[ i ];
+                int j = i;
+                for ( ; j > 0 && _oamRegion[ sprites[ j - 1 ] * 4 + 1 ] > _oamRegion[ sprite * 4 + 1 ]; --j ) {
+                    sprites[ j ] = sprites[ j - 1 ];
+                }
+                sprites[ j ] = sprite;
+            }
+        }
+        _areSpritesSorted = true;
     }
 
     void VideoDisplay::computeLine( int y, int scx, int scy, unsigned char wx, unsigned char wy )
     {
         JFX_CMP_ASSERT( y, >=, 0 );
         JFX_CMP_ASSERT( y, <, 144 );
+        if ( _hasDirtyTiles ) {
+            decodeDirtyTiles();
+        }
         bool isTile8x16 = getBit( _lcdc, 2 );
 
         const bool dataSelect = ( _lcdc & ( 1 << 4 ) ) != 0;
@@ -133,113 +217,107 @@ namespace gbemu {
         // 32x32 tile grid start address
         const std::array< unsigned short, 2 > kTileMapStart{ { 0x9800, 0x9C00 } };
 
-        std::array< Color, 4 > bgPalette;
-        std::array< Color, 4 > sprite0Palette;
-        std::array< Color, 4 > sprite1Palette;
-        decodePalette( bgPalette, _bgp );
-        decodePalette( sprite0Palette, _obp0 );
-        decodePalette(sprite1Palette, _obp1);
-
         drawTiles(
            scx, scy, y, kTileMapStart[ bgMapDataSelect ], dataSelect,
-           kTileTableStart[ dataSelect ], bgPalette, 0, 0
+           kTileTableStart[ dataSelect ], 0, 0
         );
         if ( getBit( _lcdc, 5 ) ) {
             if ( wy <= 143 && wx <= 166 && wy <= y ) {
                 drawTiles(
                     0, 0, y, kTileMapStart[ windowMapDataSelect ], dataSelect,
-                    kTileTableStart[ dataSelect ], bgPalette, (unsigned char)std::max( 0, wx - 7 ), wy );
+                    kTileTableStart[ dataSelect ], (unsigned char)std::max( 0, wx - 7 ), wy );
             }
         }
+        scanline::applyPalette( _lineIndices, _lineShades, 160, _bgp );
 
         if ( getBit( _lcdc, 1 ) ) {
-            unsigned short addr = 0xfe00;
-            while( addr < 0xfea0 ) {
-                int spriteY = _memory.readByte( addr++ );
-                int spriteX = _memory.readByte( addr++ );
-                const unsigned char spriteIndex = _memory.readByte( addr++ );
-                const unsigned char spriteAttr = _memory.readByte( addr++ );
-
-                if ( spriteX == 0 || spriteY == 0 ||
-                    spriteX >= 168 || spriteY >= 160 )
-                {
-                    // sprite hidden, continue
-                    continue;
+            if ( !_areSpritesSorted ) {
+                sortSprites();
+            }
+            const int spriteHeight = isTile8x16 ? 16 : 8;
+            // Pixels already taken by a sprite of higher priority.
+            bool isSpritePixel[ 160 ] = {};
+            for ( int slot = 0; slot < _lineSpriteCounts[ y ]; ++slot ) {
+                const unsigned char* const sprite = &_oamRegion[ _lineSprites[ y ][ slot ] * 4 ];
+                const int spriteY = sprite[ 0 ] - 16;
+                const int spriteX = sprite[ 1 ] - 8;
+                const unsigned char spriteIndex = sprite[ 2 ];
+                const unsigned char spriteAttr = sprite[ 3 ];
+
+                int spriteLine = y - spriteY;
+                JFX_CMP_ASSERT( spriteLine, >=, 0 );
+                JFX_CMP_ASSERT( spriteLine, <, spriteHeight );
+
+                // If the sprite is flipped on the Y axis, flip the spriteLine
+                if ( getBit( spriteAttr, 6 ) ) {
+                    spriteLine = (spriteHeight - 1) - spriteLine;
                 }
 
-                spriteY -= 16;
-                spriteX -= 8;
-
-                const int spriteHeight = isTile8x16 ? 16 : 8;
-                // If that's sprite sits on the scanline
-                if ( between( spriteY, spriteY + spriteHeight, y ) ) {
-                    int spriteLine = y - spriteY;
-                    JFX_CMP_ASSERT( spriteLine, >=, 0 );
-
-                    // If the sprite is flipped on the Y axis, flip the spriteLine
-                    if ( getBit( spriteAttr, 6 ) ) {
-                        spriteLine = (spriteHeight - 1) - spriteLine;
+                // The bottom half of a 8x16 sprite is the next tile.
+                unsigned short tileAddr;
+                if ( isTile8x16 ) {
+                    tileAddr = (unsigned short)(kTileDataStart + ( ( spriteLine < 8 ? spriteIndex & 0xFE : spriteIndex | 0x1 ) * 16 ));
+                }
+                else {
+                    tileAddr = (unsigned short)(kTileDataStart + spriteIndex * 16);
+                }
+                // If the sprite is flipped on the X axis, its pixels are read
+                // from the mirrored tile.
+                const unsigned char* const spriteRow = getTileRow( tileAddr, spriteLine % 8, getBit( spriteAttr, 5 ) );
+                const unsigned char palette = getBit( spriteAttr, 4 ) ? _obp1 : _obp0;
+
+                // Sprites partly off screen are clipped.
+                const int first = std::max( 0, -spriteX );
+                const int last = std::min( 8, 160 - spriteX );
+                for ( int i = first; i < last; ++i ) {
+                    const int x = spriteX + i;
+                    const unsigned char colorIndex = spriteRow[ i ];
+                    // The transparent pixels let the sprites below show.
+                    if ( colorIndex == 0 || isSpritePixel[ x ] ) {
+                        continue;
                     }
-
-                    // for each pixel on the y axis
-                    for ( unsigned char i = 0; i < 8; ++i ) {
-                        // If that pixel is outside the screen, skip it
-                        if ( !between( 0, 160, spriteX + i ) ) {
-                            continue;
-                        }
-
-                        unsigned short spriteLineBytes;
-                        if ( isTile8x16 ) {
-                            if ( spriteLine < 8 ) {
-                                // Select sprite
-                                const unsigned short wordAddr = (unsigned short)(0x8000 + ( ( spriteIndex & 0xFE ) * 16 ) + ( spriteLine * 2 ));
-                                spriteLineBytes = _memory.readWord( wordAddr );
-                            }
-                            else {
-                                const unsigned short wordAddr = (unsigned short)(0x8000 + ( ( spriteIndex | 0x1 ) * 16 ) + ( ( spriteLine - 8 ) * 2 ));
-                                spriteLineBytes = _memory.readWord( wordAddr );
-                            }
-                        }
-                        else {
-                            const unsigned short wordAddr = (unsigned short)(0x8000 + spriteIndex * 16 + ( spriteLine * 2 ));
-                            spriteLineBytes = _memory.readWord( wordAddr );
-                        }
-
-                        // compute the bit we have to read. Bit 0 is the rightmost pixel.
-                        // If we are mirroring, we start from bit 0 to display pixels
-                        const unsigned int bitPos = getBit( spriteAttr, 5 ) ? i : 7 - i;
-
-                        const size_t colorIndex = (size_t)(getBit( spriteLineBytes & 0xFF, bitPos ) +
-                            ( getBit( ( ( spriteLineBytes & 0xFF00 ) >> 8 ), bitPos ) << 1 ));
-
-                        JFX_CMP_ASSERT( y, >=, 0 );
-                        JFX_CMP_ASSERT( y, <, 144 );
-                        JFX_CMP_ASSERT( i + spriteX, >=, 0 );
-                        JFX_CMP_ASSERT( i + spriteX, <, 160 );
-
-                        // if object over background
-                        if ( !getBit( spriteAttr, 7 ) ) {
-                            if ( colorIndex == 0 ) {
-                                continue;
-                            }
-                        }
-                        else {
-                            if ( getPixel( spriteX + i, y ) != bgPalette[ 0 ] ) {
-                                continue;
-                            }
-                        }
-
-                        getPixel( spriteX + i, y ) = getBit( spriteAttr, 4 ) ? sprite1Palette[ colorIndex ] : sprite0Palette[ colorIndex ];
+                    isSpritePixel[ x ] = true;
+                    // A sprite behind the background only shows over its
+                    // color 0.
+                    if ( getBit( spriteAttr, 7 ) && _lineIndices[ x ] != 0 ) {
+                        continue;
                     }
+                    _lineShades[ x ] = ( palette >> ( colorIndex * 2 ) ) & 0x3;
                 }
-
             }
-            JFX_CMP_ASSERT( addr, ==, 0xfea0 );
+        }
+
+        storeLine( y );
+    }
+
+    void VideoDisplay::storeLine( const int y )
+    {
+        unsigned char* const pixels = &_pixels[ y * 160 * _bytesPerPixel ];
+        switch ( _bytesPerPixel ) {
+            case 1:
+                storePixels< 1 >( pixels, _lineShades, _shadePixels );
+                break;
+            case 2:
+                storePixels< 2 >( pixels, _lineShades, _shadePixels );
+                break;
+            case 3:
+                storePixels< 3 >( pixels, _lineShades, _shadePixels );
+                break;
+            default:
+                storePixels< 4 >( pixels, _lineShades, _shadePixels );
+                break;
         }
     }
 
     void VideoDisplay::emulate( int nbCycles )
     {
+        if ( _dmaCycles > 0 ) {
+            _dmaCycles -= nbCycles;
+            if ( _dmaCycles <= 0 ) {
+                _dmaCycles = 0;
+                _memory.setDMAActive( false );
+            }
+        }
         _lcdCycle += nbCycles;
         unsigned char stat( _stat );
         unsigned char mode( ( stat & 0x03 ) );
@@ -305,7 +383,7 @@ namespace gbemu {
                 if ( mode != 1 ) {
                     _isFrameReady = true;
                     // set vblank interrupt flag
-                    _memory.memoryRegister( kIF ) |= Memory::kIFVBlankFlag;
+                    _memory.requestInterrupt( Memory::kIFVBlankFlag );
                     if ( mode != 2 && getBit( _stat, 4 ) ) {
                         setLCDCInterruptFlag();
                     }
@@ -320,9 +398,37 @@ namespace gbemu {
         _stat = stat;
     }
 
+    int VideoDisplay::getCyclesToNextEvent() const
+    {
+        const int nbCycles = getCyclesToNextLCDEvent();
+        // The end of a DMA transfer gives the bus back to the cpu.
+        return _dmaCycles > 0 ? std::min( nbCycles, _dmaCycles ) : nbCycles;
+    }
+
+    int VideoDisplay::getCyclesToNextLCDEvent() const
+    {
+        // Nothing happens while the display is off.
+        if ( ( _lcdc & kLCDEnabledBit ) == 0 ) {
+            return kLCDCycleLength;
+        }
+        if ( _lcdCycle >= kVBlankStart ) {
+            return k023ModeCycleLength - _lcdCycle % k023ModeCycleLength;
+        }
+        const int modeCycle( _lcdCycle % k023ModeCycleLength );
+        if ( modeCycle < kMode2Start ) {
+            return kMode2Start - modeCycle;
+        }
+        else if ( modeCycle < kMode3Start ) {
+            return kMode3Start - modeCycle;
+        }
+        else {
+            return k023ModeCycleLength - modeCycle;
+        }
+    }
+
     void VideoDisplay::setLCDCInterruptFlag()
     {
-        setBit( _memory.memoryRegister( kIF ), 1 );
+        _memory.requestInterrupt( Memory::kIFHVBlankFlag );
     }
 
     bool VideoDisplay::isFrameReady() const
@@ -334,13 +440,39 @@ namespace gbemu {
         return false;
     }
 
-    const Color* VideoDisplay::getPixels() const
+    const unsigned char* VideoDisplay::getPixels() const
     {
-        return &( _pixels[ 0 ][ 0 ] );
+        return _pixels;
+    }
+
+    PixelFormat VideoDisplay::getPixelFormat() const
+    {
+        return _pixelFormat;
+    }
+
+    int VideoDisplay::getBytesPerPixel( const PixelFormat format )
+    {
+        switch ( format ) {
+            case PixelFormat::ShadeIndex:
+                return 1;
+            case PixelFormat::RGB565:
+                return 2;
+            case PixelFormat::RGB888:
+                return 3;
+            case PixelFormat::RGBA8888:
+            case PixelFormat::BGRA8888:
+                return 4;
+        }
+        JFX_MSG_ABORT( "Unknown pixel format." );
+        return 0;
     }
 
     void VideoDisplay::writeByte(unsigned short addr, unsigned char value) {
         if (addr == kLCDC) {
+            // The height of the sprites decides which lines they sit on.
+            if (getBit(_lcdc, 2) != getBit(value, 2)) {
+                _areSpritesSorted = false;
+            }
             _lcdc = value;
         }
         else if (addr == kSCX) {
@@ -361,13 +493,22 @@ namespace gbemu {
             _ly = value;
         }
         else if (addr == kDMA) {
-            for (unsigned short i = 0; i < (0xFEA0 - 0xFE00); ++i) {
-                _oamRegion[i] = _memory.readByte((value * 256) + i);
+            // A new transfer restarts the window, its source has to be
+            // readable again.
+            if (_dmaCycles > 0) {
+                _memory.setDMAActive(false);
             }
+            // The bytes are copied right away, the cpu is only kept off the
+            // bus for as long as the transfer would have lasted.
+            _memory.readBytes(static_cast< unsigned short >(value * 256), _oamRegion, sizeof(_oamRegion));
             _dmaRegister = value;
+            _dmaCycles = kDMACycleLength;
+            _areSpritesSorted = false;
+            _memory.setDMAActive(true);
         }
         else if (isOAM(addr)) {
             _oamRegion[addr - 0xFE00] = value;
+            _areSpritesSorted = false;
         }
         else if (addr == kBGP) {
             _bgp = value;
@@ -393,12 +534,20 @@ namespace gbemu {
             else {
                 _videoRam[addr - 0x8000] = value;
             }
+            if (addr < kTileMapStart) {
+                _dirtyTiles[(addr - kTileDataStart) / 16] = true;
+                _hasDirtyTiles = true;
+            }
         }
         else {
             JFX_MSG_ABORT("Unknown video memory address: " << addr);
         }
     }
 
+    unsigned char* VideoDisplay::getVideoRAM() {
+        return _videoRam;
+    }
+
     unsigned char VideoDisplay::readByte(unsigned short addr) const {
         if (addr == kLCDC) {
             return _lcdc;
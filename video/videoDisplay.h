@@ -7,32 +7,18 @@ namespace gbemu {
 
     class Memory;
 
-    struct Color
+    // Layout of the pixels of a frame, row by row from the top left corner.
+    enum class PixelFormat
     {
-        Color()
-        {}
-
-        Color( unsigned char r, unsigned char g, unsigned char b )
-        {
-            components[ 0 ] = r;
-            components[ 1 ] = g;
-            components[ 2 ] = b;
-        }
-        inline bool operator==( const Color& color ) const
-        {
-            for( int i = 0; i < 3; ++i ) {
-                if ( components[ i ] != color.components[ i ] ) {
-                    return false;
-                }
-            }
-            return true;
-        }
-        inline bool operator!=( const Color& color )
-        {
-            return !operator==( color );
-        }
-    private:
-        unsigned char components[3];
+        // The DMG shade of each pixel, 0 for the lightest to 3, one byte
+        // each.
+        ShadeIndex,
+        // 16 bit words in the host's byte order, red in the 5 high bits.
+        RGB565,
+        // One byte per component, in that order.
+        RGB888,
+        RGBA8888,
+        BGRA8888
     };
 
     class VideoDisplay : public WordIOProtocol< VideoDisplay >
@@ -42,15 +28,31 @@ namespace gbemu {
         static bool isOAM(unsigned short addr);
         static bool isVideoMemory(unsigned short addr);
 
-        VideoDisplay( Memory& memory, bool isInitialized );
+        // The tile data, followed by the two tile maps.
+        static const unsigned short kTileDataStart = 0x8000;
+        static const unsigned short kTileMapStart = 0x9800;
+        static const int kTileCount = ( kTileMapStart - kTileDataStart ) / 16;
+
+        static int getBytesPerPixel( PixelFormat format );
+
+        VideoDisplay( Memory& memory, bool isInitialized, PixelFormat pixelFormat );
         void emulate( int nbCycles );
+        // Number of cycles before the next STAT mode or LY change, which is
+        // where lines are drawn and the LCD interrupts are raised.
+        int getCyclesToNextEvent() const;
         bool isFrameReady() const;
-        const Color* getPixels() const;
+        // The 160x144 pixels of the last frame, in the pixel format.
+        const unsigned char* getPixels() const;
+        PixelFormat getPixelFormat() const;
         void writeByte(unsigned short addr, unsigned char byte);
         unsigned char readByte(unsigned short addr) const;
+        unsigned char* getVideoRAM();
     private:
 
-        Color& getPixel(int x, int y);
+        JFX_INLINE unsigned char readVideoRAMByte( unsigned short addr ) const;
+        // Color indices of a row of the tile at addr, mirrored if flipX.
+        JFX_INLINE const unsigned char* getTileRow( unsigned short tileAddr, int row, bool flipX ) const;
+        void decodeDirtyTiles();
         void drawTiles(
             const int                     scx,
             const int                     scy,
@@ -58,14 +60,17 @@ namespace gbemu {
             const unsigned short          bgTileMapStart,
             const bool                    dataSelect,
             const unsigned short          tileTableStart,
-            const std::array< Color, 4 >& bgPalette,
             const unsigned char           offsetX,
             const unsigned char           offsetY
         );
 
         VideoDisplay& operator=( const VideoDisplay& );
 
+        int getCyclesToNextLCDEvent() const;
+        // Lists the sprites of each line, in the order of their priority.
+        void sortSprites();
         void computeLine( int y, int scx, int scy, unsigned char wx, unsigned char wy );
+        void storeLine( int y );
         void setLCDCInterruptFlag();
 
         const static int kMode0Start = 0;
@@ -79,6 +84,12 @@ namespace gbemu {
 
         const static int kLCDEnabledBit = 1 << 7;
 
+        // An OAM DMA transfer lasts 160 microseconds.
+        const static int kDMACycleLength = 640;
+
+        const static int kSpriteCount = 40;
+        const static int kMaxSpritesPerLine = 10;
+
         Memory& _memory;
         int _lcdCycle;
         mutable bool _isFrameReady;
@@ -91,6 +102,13 @@ namespace gbemu {
         unsigned char _ly;
         unsigned char _oamRegion[ 0XFEA0 - 0xFE00 ];
         unsigned char _dmaRegister;
+        // Cycles left before the DMA transfer lets go of the bus.
+        int _dmaCycles;
+        // The sprites displayed on each line, sorted again once the OAM or
+        // the height of the sprites changed.
+        unsigned char _lineSprites[ 144 ][ kMaxSpritesPerLine ];
+        int _lineSpriteCounts[ 144 ];
+        bool _areSpritesSorted;
         unsigned char _bgp;
         unsigned char _obp0;
         unsigned char _obp1;
@@ -98,6 +116,35 @@ namespace gbemu {
         unsigned char _wy;
         unsigned char _videoRam[ 0xA000 - 0x8000 ];
 
-        Color _pixels[ 144 ][ 160 ];
+        // The tiles decoded to one color index per pixel, and mirrored for
+        // the sprites flipped horizontally. Writes to the tile data mark
+        // them dirty and they are decoded again before the next line.
+        unsigned char _tiles[ kTileCount ][ 8 ][ 8 ];
+        unsigned char _flippedTiles[ kTileCount ][ 8 ][ 8 ];
+        bool _dirtyTiles[ kTileCount ];
+        bool _hasDirtyTiles;
+
+        // Color indices of the background and the window on the line being
+        // drawn, then the shades of its pixels.
+        unsigned char _lineIndices[ 160 ];
+        unsigned char _lineShades[ 160 ];
+
+        // The palette is only applied when a line is stored to the frame,
+        // with the bytes of each shade in the pixel format.
+        const PixelFormat _pixelFormat;
+        const int _bytesPerPixel;
+        unsigned char _shadePixels[ 4 ][ 4 ];
+        unsigned char _pixels[ 144 * 160 * 4 ];
     };
+
+    unsigned char VideoDisplay::readVideoRAMByte( const unsigned short addr ) const
+    {
+        return _videoRam[ addr - 0x8000 ];
+    }
+
+    const unsigned char* VideoDisplay::getTileRow( const unsigned short tileAddr, const int row, const bool flipX ) const
+    {
+        const int tile = ( tileAddr - kTileDataStart ) / 16;
+        return flipX ? _flippedTiles[ tile ][ row ] : _tiles[ tile ][ row ];
+    }
 }